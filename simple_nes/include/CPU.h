@@ -1,6 +1,10 @@
 #ifndef CPU_H
 #define CPU_H
+#include <array>
+#include <utility>
 #include "MainBus.h"
+#include "CPUOpcodes.h"
+#include "SaveState.h"
 
 namespace sn
 {
@@ -21,20 +25,45 @@ namespace sn
             void interrupt(InterruptType type);
 
             void step();
+            //Cycles step() spends waiting on the current instruction before it executes the next one
+            int getCyclesToNextInstruction() const { return m_skipCycles > 1 ? m_skipCycles - 1 : 0; }
+            //Same as calling step() getCyclesToNextInstruction() + 1 times
+            void executeNext();
             void reset();
             void reset(Address start_addr);
             void log();
 
             Address getPC() { return r_PC; }
             void skipDMACycles();
+
+            void saveState(StateWriter& writer) const;
+            bool loadState(StateReader& reader);
         private:
-            //Instructions are split into five sets to make decoding easier.
-            //These functions return true if they succeed
-            bool executeImplied(Byte opcode);
-            bool executeBranch(Byte opcode);
-            bool executeType0(Byte opcode);
-            bool executeType1(Byte opcode);
-            bool executeType2(Byte opcode);
+            void execute();
+
+            //One instance per opcode, the operation and addressing mode are decoded at compile time
+            template <OperationImplied Op> void executeImplied();
+            template <BranchOnFlag Flag, bool Condition> void executeBranch();
+            template <Operation0 Op, AddrMode2 Mode> void executeType0();
+            template <Operation1 Op, AddrMode1 Mode> void executeType1();
+            template <Operation2 Op, AddrMode2 Mode> void executeType2();
+            template <Byte Opcode> void executeUnused();
+
+            struct Instruction
+            {
+                void (CPU::*execute)();
+                int cycles;
+            };
+
+            //Picks the template instance and cycle count of an opcode
+            template <Byte Opcode, InstructionSet Set = getInstructionSet(Opcode)>
+            struct Decode;
+
+            template <std::size_t... Opcodes>
+            static constexpr std::array<Instruction, 0x100> makeInstructionTable(std::index_sequence<Opcodes...>);
+
+            //Indexed by opcode
+            static const std::array<Instruction, 0x100> m_instructions;
 
             Address readAddress(Address addr);
 
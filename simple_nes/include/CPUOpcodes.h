@@ -1,8 +1,11 @@
 #ifndef CPUOPCODES_H_INCLUDED
 #define CPUOPCODES_H_INCLUDED
+#include <cstdint>
 
 namespace sn
 {
+    using Byte = std::uint8_t;
+
     const auto InstructionModeMask = 0x3;
 
     const auto OperationMask = 0xe0;
@@ -121,7 +124,7 @@ namespace sn
     };
 
     //0 implies unused opcode
-    int OperationCycles[0x100] = {
+    constexpr int OperationCycles[0x100] = {
             7, 6, 0, 0, 0, 3, 5, 0, 3, 2, 2, 0, 0, 4, 6, 0,
             2, 5, 0, 0, 0, 4, 6, 0, 2, 4, 0, 0, 0, 4, 7, 0,
             6, 6, 0, 0, 3, 3, 5, 0, 4, 2, 2, 0, 4, 4, 6, 0,
@@ -139,6 +142,48 @@ namespace sn
             2, 6, 0, 0, 3, 3, 5, 0, 2, 2, 2, 2, 4, 4, 6, 0,
             2, 5, 0, 0, 0, 4, 6, 0, 2, 4, 0, 0, 0, 4, 7, 0,
         };
+
+    //Instructions are split into five sets to make decoding easier
+    enum InstructionSet
+    {
+        ImpliedSet,
+        BranchSet,
+        Type1Set,
+        Type2Set,
+        Type0Set,
+        UnusedSet,
+    };
+
+    constexpr bool isImplied(Byte opcode)
+    {
+        switch (opcode)
+        {
+            case NOP: case BRK: case JSR: case RTI: case RTS: case JMP: case JMPI:
+            case PHP: case PLP: case PHA: case PLA:
+            case DEY: case DEX: case TAY: case INY: case INX:
+            case CLC: case SEC: case CLI: case SEI: case TYA: case CLV: case CLD: case SED:
+            case TXA: case TXS: case TAX: case TSX:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    constexpr Byte getOperation(Byte opcode) { return (opcode & OperationMask) >> OperationShift; }
+    constexpr Byte getAddrMode(Byte opcode) { return (opcode & AddrModeMask) >> AddrModeShift; }
+
+    //Checked in this order, implied before branches and branches before type 0
+    constexpr InstructionSet getInstructionSet(Byte opcode)
+    {
+        return !OperationCycles[opcode] ? UnusedSet :
+               isImplied(opcode) ? ImpliedSet :
+               (opcode & BranchInstructionMask) == BranchInstructionMaskResult ? BranchSet :
+               (opcode & InstructionModeMask) == 0x1 ? Type1Set :
+               (opcode & InstructionModeMask) == 0x2 && getAddrMode(opcode) != 4 && getAddrMode(opcode) != 6 ? Type2Set :
+               (opcode & InstructionModeMask) == 0x0 && getAddrMode(opcode) != 2 && getAddrMode(opcode) != 4 && getAddrMode(opcode) != 6 &&
+                    getOperation(opcode) != 0 && getOperation(opcode) != 2 && getOperation(opcode) != 3 ? Type0Set :
+               UnusedSet;
+    }
 }
 
 #endif // CPUOPCODES_H_INCLUDED
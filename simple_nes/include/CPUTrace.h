@@ -0,0 +1,34 @@
+#ifndef CPUTRACE_H
+#define CPUTRACE_H
+#include "Emulator.h"
+#include <istream>
+#include <string>
+
+namespace sn
+{
+    //One line of a Nintendulator style trace, like nestest.log or the --log-cpu dump, the state before the instruction runs
+    struct CPUTraceLine
+    {
+        Address pc;
+        Byte opcode;
+        Byte a;
+        Byte x;
+        Byte y;
+        Byte p;
+        Byte sp;
+        //The PPU dot of the older logs, or the CPU cycle count in logs that have a separate "PPU:" column
+        int cycle;
+        bool cpuCycles;
+    };
+
+    //False if the line is missing any of the registers
+    bool parseCPUTraceLine(const std::string& line, CPUTraceLine& out);
+
+    //Runs the emulator an instruction at a time and compares each with the next line of the trace: the registers,
+    //the opcode and the cycles since the last line, so every entry of the opcode table and its cycle count is checked.
+    //Point the CPU at the start of the trace first, nestest's automated run starts at $C000 (Emulator::resetCPU).
+    //Logs the first line that differs, true if the whole trace matched. Uses the global CPU trace log while it runs
+    bool checkCPUTrace(Emulator& emulator, std::istream& trace);
+}
+
+#endif // CPUTRACE_H
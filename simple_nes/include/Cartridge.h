@@ -3,25 +3,30 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <memory>
 
 namespace sn
 {
     using Byte = std::uint8_t;
     using Address = std::uint16_t;
 
+    //Copies share the same read only PRG and CHR data, CHR-RAM lives in the mapper
     class Cartridge
     {
         public:
             Cartridge();
             bool loadFromFile(std::string path);
-            const std::vector<Byte>& getROM();
-            const std::vector<Byte>& getVROM();
-            Byte getMapper();
-            Byte getNameTableMirroring();
-            bool hasExtendedRAM();
+            const std::vector<Byte>& getROM() const;
+            const std::vector<Byte>& getVROM() const;
+            Byte getMapper() const;
+            Byte getNameTableMirroring() const;
+            bool hasExtendedRAM() const;
+            //Hash of the image contents, 0 if nothing is loaded
+            std::size_t getHash() const;
         private:
-            std::vector<Byte> m_PRG_ROM;
-            std::vector<Byte> m_CHR_ROM;
+            std::shared_ptr<const std::vector<Byte>> m_PRG_ROM;
+            std::shared_ptr<const std::vector<Byte>> m_CHR_ROM;
+            std::size_t m_hash;
             Byte m_nameTableMirroring;
             Byte m_mapperNumber;
             bool m_extendedRAM;
@@ -0,0 +1,25 @@
+#ifndef CARTRIDGEREGISTRY_H
+#define CARTRIDGEREGISTRY_H
+#include "Cartridge.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <memory>
+
+namespace sn
+{
+    //Loads and validates each ROM image once, every later request for the same path shares it
+    class CartridgeRegistry
+    {
+        public:
+            //nullptr if the image could not be loaded, failures are not cached
+            static std::shared_ptr<const Cartridge> load(const std::string& path);
+            //Drops the registry's references, cartridges still in use stay alive
+            static void clear();
+        private:
+            static std::mutex m_mutex;
+            static std::map<std::string, std::shared_ptr<const Cartridge>> m_cartridges;
+    };
+}
+
+#endif // CARTRIDGEREGISTRY_H
@@ -1,10 +1,10 @@
 #ifndef CONTROLLER_H
 #define CONTROLLER_H
-#include <SFML/Window.hpp>
 #include <cstdint>
 #include <vector>
 #include <map>
 #include <functional>
+#include "SaveState.h"
 
 namespace sn
 {
@@ -28,15 +28,20 @@ namespace sn
 
         void strobe(Byte b);
         Byte read();
-        void setKeyBindings(const std::vector<sf::Keyboard::Key>& keys);
         void setCallbacks(const std::vector<std::function<bool(void)>>& callbacks);
         void setCallbackMap(const std::map<Buttons,std::function<bool(void)>>& callbacks);
+        //Bit n is the state of button n. The callbacks are ignored until they are set again
+        void setButtonStates(Byte buttons);
+
+        void saveState(StateWriter& writer) const;
+        bool loadState(StateReader& reader);
     private:
         bool m_strobe;
         unsigned int m_buttonStates;
 
+        bool m_useCallbacks;
+        Byte m_buttonMask;
         std::vector<std::function<bool(void)>> m_buttonCallbacks;
-//        std::vector<sf::Keyboard::Key> m_keyBindings;
     };
 }
 
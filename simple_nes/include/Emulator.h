@@ -1,8 +1,5 @@
 #ifndef EMULATOR_H
 #define EMULATOR_H
-#include <SFML/Graphics.hpp>
-#include <chrono>
-
 #include "CPU.h"
 #include "PPU.h"
 #include "MainBus.h"
@@ -14,30 +11,53 @@ namespace sn
     const int NESVideoWidth = ScanlineVisibleDots;
     const int NESVideoHeight = VisibleScanlines;
 
+    //The emulator core, pure C++ so headless users never need a graphics context. See EmulatorWindow for the SFML front end
     class Emulator
     {
     public:
         Emulator();
         bool init(const std::string& rom_path);
+        bool init(const Cartridge& cartridge);
+        //One CPU cycle and the three PPU cycles that go with it
+        void step();
         void stepFrame();
         void stepNFrames( uint64_t n );
-        void run(const std::string& rom_path);
+        //Runs the CPU from start_addr instead of the reset vector, nestest's automated mode starts at $C000
+        void resetCPU(Address start_addr);
+
+        //Only the pixels of frames drawn in DrawPixels mode reach getScreenData
+        void setRenderMode(RenderMode mode);
 
-        void setVideoWidth(int width);
-        void setVideoHeight(int height);
-        void setVideoScale(float scale);
-        void setKeys(const std::vector<sf::Keyboard::Key>& p1, const std::vector<sf::Keyboard::Key>& p2);
         void setControllerCallbacks(const std::vector<std::function<bool(void)>>& p1, const std::vector<std::function<bool(void)>>& p2);
         void setControllerCallbackMap(const std::map<Controller::Buttons,std::function<bool(void)>>& p1, const std::map<Controller::Buttons,std::function<bool(void)>>& p2);
+        //Port 0 is player 1, bit n of buttons is Controller::Buttons n. Replaces that port's callbacks until they are set again
+        void setControllerState(size_t port, Byte buttons);
 
         Byte peakMemory(Address addr) const;
-        std::shared_ptr<sf::Image> getScreenData() const;
+        //The last complete frame, updated in place as the emulator runs
+        std::shared_ptr<const FrameBuffer> getScreenData() const;
         uint64_t getNumVBlank() const;
+
+        //Only valid on an emulator initialized with the same cartridge
+        SaveState saveState() const;
+        bool loadState(const SaveState& state);
+
+        //A fork shares the cartridge ROM and copies the rest of the machine, a few KB, so it can run ahead
+        //on other input. Controller input and callbacks are not copied. Without copyScreen the screen of
+        //a fork is only valid once it finishes a frame
+        std::unique_ptr<Emulator> fork(bool copyScreen = false) const;
+        //Same as fork, but reuses an existing emulator, the cheap way to fork over and over
+        bool forkInto(Emulator& target, bool copyScreen = false) const;
     private:
+        bool setupCartridge();
+        //Everything in a save state except the header and the picture
+        void saveMachineState(StateWriter& writer) const;
+        bool loadMachineState(StateReader& reader);
         void DMA(Byte page);
 
         MainBus m_bus;
         PictureBus m_pictureBus;
+        std::shared_ptr<FrameBuffer> m_frameBuffer;
         CPU m_cpu;
         PPU m_ppu;
         uint64_t m_vblankCounter;
@@ -47,10 +67,8 @@ namespace sn
 
         Controller m_controller1, m_controller2;
 
-        VirtualScreen m_emulatorScreen;
-        float m_screenScale;
-
-        std::chrono::nanoseconds m_cpuCycleDuration;
+        //Scratch space for forks into this emulator
+        SaveState m_forkBuffer;
     };
 }
 #endif // EMULATOR_H
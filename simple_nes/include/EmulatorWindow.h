@@ -0,0 +1,33 @@
+#ifndef EMULATORWINDOW_H
+#define EMULATORWINDOW_H
+#include <SFML/Graphics.hpp>
+#include <chrono>
+
+#include "Emulator.h"
+#include "VirtualScreen.h"
+
+namespace sn
+{
+    //The SFML front end, plays an emulator in a window with keyboard input
+    class EmulatorWindow
+    {
+    public:
+        EmulatorWindow();
+        void run(const std::string& rom_path);
+
+        void setVideoWidth(int width);
+        void setVideoHeight(int height);
+        void setVideoScale(float scale);
+        void setKeys(const std::vector<sf::Keyboard::Key>& p1, const std::vector<sf::Keyboard::Key>& p2);
+
+        Emulator& getEmulator();
+    private:
+        Emulator m_emulator;
+
+        VirtualScreen m_emulatorScreen;
+        float m_screenScale;
+
+        std::chrono::nanoseconds m_cpuCycleDuration;
+    };
+}
+#endif // EMULATORWINDOW_H
@@ -0,0 +1,43 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+#include <cstddef>
+#include "SaveState.h"
+
+namespace sn
+{
+    //The picture as 6 bit palette indices, row major. The PPU draws into the back buffer
+    //while the front one holds the last complete frame, RGB only exists when someone asks for it
+    class FrameBuffer
+    {
+    public:
+        static const std::size_t Width = 256;
+        static const std::size_t Height = 240;
+
+        FrameBuffer(Byte fillIndex = 0x0f);
+
+        void setPixel(std::size_t x, std::size_t y, Byte paletteIndex) { m_frames[m_front ^ 1][y][x] = paletteIndex & 0x3f; }
+        //Makes the back buffer the last complete frame
+        void swap() { m_front ^= 1; }
+
+        //Width * Height indices of the last complete frame, valid until the next swap
+        const Byte* getFrame() const { return &m_frames[m_front][0][0]; }
+        Byte getPixel(std::size_t x, std::size_t y) const { return m_frames[m_front][y][x]; }
+
+        //Uses the same buffer as the front one as another frame buffer does, and copies its last complete frame
+        //unless copyPixels is false. After that both stay in step as long as they are drawn the same
+        void copyFrame(const FrameBuffer& other, bool copyPixels = true);
+
+        //Width * Height * 4 bytes
+        void copyRGBA(Byte* destination) const;
+        //The 4 RGBA bytes of a palette index
+        static const Byte* getPaletteRGBA(Byte paletteIndex);
+
+        void saveState(StateWriter& writer) const;
+        bool loadState(StateReader& reader);
+
+    private:
+        Byte m_frames[2][Height][Width];
+        int m_front;
+    };
+}
+#endif // FRAMEBUFFER_H
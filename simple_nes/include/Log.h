@@ -42,6 +42,9 @@ namespace sn
 
         static Log& get();
     private:
+        //Both streams start out as std::cout, so they can always be swapped out and back
+        Log();
+
         Level m_logLevel;
         std::ostream* m_logStream;
         std::ostream* m_cpuTrace;
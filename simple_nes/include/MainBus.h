@@ -1,11 +1,11 @@
 #ifndef MEMORY_H
 #define MEMORY_H
 #include <vector>
-#include <map>
 #include <functional>
 #include <memory>
 #include "Cartridge.h"
 #include "Mapper.h"
+#include "SaveState.h"
 
 namespace sn
 {
@@ -24,6 +24,9 @@ namespace sn
         JOY2 = 0x4017,
     };
 
+    class PPU;
+    class Controller;
+
     class MainBus
     {
         public:
@@ -32,16 +35,21 @@ namespace sn
             Byte peak(Address addr) const;
             void write(Address addr, Byte value);
             bool setMapper(Mapper* mapper);
-            bool setWriteCallback(IORegisters reg, std::function<void(Byte)> callback);
-            bool setReadCallback(IORegisters reg, std::function<Byte(void)> callback);
+            //The devices behind the I/O registers, called directly on every register access
+            bool connectIO(PPU* ppu, Controller* controller1, Controller* controller2, std::function<void(Byte)> dma);
             const Byte* getPagePtr(Byte page);
+
+            void saveState(StateWriter& writer) const;
+            bool loadState(StateReader& reader);
         private:
             std::vector<Byte> m_RAM;
             std::vector<Byte> m_extRAM;
             Mapper* m_mapper;
 
-            std::map<IORegisters, std::function<void(Byte)>> m_writeCallbacks;
-            std::map<IORegisters, std::function<Byte(void)>> m_readCallbacks;
+            PPU* m_ppu;
+            Controller* m_controller1;
+            Controller* m_controller2;
+            std::function<void(Byte)> m_dmaCallback;
     };
 }
 
@@ -1,6 +1,7 @@
 #ifndef MAPPER_H
 #define MAPPER_H
 #include "Cartridge.h"
+#include "SaveState.h"
 #include <memory>
 #include <functional>
 
@@ -27,27 +28,41 @@ namespace sn
                 CNROM = 3,
             };
 
-            Mapper(Cartridge& cart, Type t) : m_cartridge(cart), m_type(t) {};
+            Mapper(const Cartridge& cart, Type t) : m_cartridge(cart), m_type(t), m_pagesPRG(), m_pagesCHR() {};
             virtual ~Mapper() = default;
             virtual void writePRG (Address addr, Byte value) = 0;
-            virtual Byte readPRG (Address addr) = 0;
-            virtual const Byte* getPagePtr (Address addr) = 0; //for DMAs
+            //Reads go through the page tables, 0x8000 and up only
+            Byte readPRG (Address addr) const { return m_pagesPRG[(addr >> 13) & 0x3][addr & 0x1fff]; }
+            const Byte* getPagePtr (Address addr) const { return &m_pagesPRG[(addr >> 13) & 0x3][addr & 0x1fff]; } //for DMAs
 
-            virtual Byte readCHR (Address addr) = 0;
+            Byte readCHR (Address addr) const { return m_pagesCHR[(addr >> 10) & 0x7][addr & 0x3ff]; }
             virtual void writeCHR (Address addr, Byte value) = 0;
 
             virtual NameTableMirroring getNameTableMirroring();
 
+            //Bank registers and character RAM, the ROM itself belongs to the cartridge
+            virtual void saveState(StateWriter&) const {};
+            virtual bool loadState(StateReader& reader) { return reader.good(); };
+
             bool inline hasExtendedRAM()
             {
                 return m_cartridge.hasExtendedRAM();
             }
 
-            static std::unique_ptr<Mapper> createMapper (Type mapper_t, Cartridge& cart, std::function<void(void)> mirroring_cb);
+            static std::unique_ptr<Mapper> createMapper (Type mapper_t, const Cartridge& cart, std::function<void(void)> mirroring_cb);
 
         protected:
-            Cartridge& m_cartridge;
+            //Points size bytes of CPU space from addr (0x8000 and up) or of pattern memory from addr at memory.
+            //Mappers call these whenever their banks change, including after loading a state
+            void mapPRG(Address addr, std::size_t size, const Byte* memory);
+            void mapCHR(Address addr, std::size_t size, const Byte* memory);
+
+            const Cartridge& m_cartridge;
             Type m_type;
+
+        private:
+            const Byte* m_pagesPRG[4]; //8KB each, 0x8000 to 0xffff
+            const Byte* m_pagesCHR[8]; //1KB each, 0x0000 to 0x1fff
     };
 }
 
@@ -7,14 +7,16 @@ namespace sn
     class MapperCNROM : public Mapper
     {
         public:
-            MapperCNROM(Cartridge& cart);
+            MapperCNROM(const Cartridge& cart);
             void writePRG (Address addr, Byte value);
-            Byte readPRG (Address addr);
-            const Byte* getPagePtr(Address addr);
 
-            Byte readCHR (Address addr);
             void writeCHR (Address addr, Byte value);
+
+            void saveState(StateWriter& writer) const;
+            bool loadState(StateReader& reader);
         private:
+            void updateCHRBank();
+
             bool m_oneBank;
 
             Address m_selectCHR;
@@ -7,13 +7,13 @@ namespace sn
     class MapperNROM : public Mapper
     {
         public:
-            MapperNROM(Cartridge& cart);
+            MapperNROM(const Cartridge& cart);
             void writePRG (Address addr, Byte value);
-            Byte readPRG (Address addr);
-            const Byte* getPagePtr(Address addr);
 
-            Byte readCHR (Address addr);
             void writeCHR (Address addr, Byte value);
+
+            void saveState(StateWriter& writer) const;
+            bool loadState(StateReader& reader);
         private:
             bool m_oneBank;
             bool m_usesCharacterRAM;
@@ -7,17 +7,18 @@ namespace sn
     class MapperSxROM : public Mapper
     {
         public:
-            MapperSxROM(Cartridge& cart, std::function<void(void)> mirroring_cb);
+            MapperSxROM(const Cartridge& cart, std::function<void(void)> mirroring_cb);
             void writePRG (Address addr, Byte value);
-            Byte readPRG (Address addr);
-            const Byte* getPagePtr(Address addr);
 
-            Byte readCHR (Address addr);
             void writeCHR (Address addr, Byte value);
 
+            void saveState(StateWriter& writer) const;
+            bool loadState(StateReader& reader);
+
             NameTableMirroring getNameTableMirroring();
         private:
             void calculatePRGPointers();
+            void updatePageTables();
 
             std::function<void(void)> m_mirroringCallback;
             NameTableMirroring m_mirroing;
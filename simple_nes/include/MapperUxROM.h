@@ -7,14 +7,16 @@ namespace sn
     class MapperUxROM : public Mapper
     {
         public:
-            MapperUxROM(Cartridge& cart);
+            MapperUxROM(const Cartridge& cart);
             void writePRG (Address addr, Byte value);
-            Byte readPRG (Address addr);
-            const Byte* getPagePtr(Address addr);
 
-            Byte readCHR (Address addr);
             void writeCHR (Address addr, Byte value);
+
+            void saveState(StateWriter& writer) const;
+            bool loadState(StateReader& reader);
         private:
+            void updatePRGBank();
+
             bool m_usesCharacterRAM;
 
             const Byte* m_lastBankPtr;
@@ -2,10 +2,11 @@
 #define PPU_H
 #include <functional>
 #include <array>
+#include <vector>
 #include "PictureBus.h"
 #include "MainBus.h"
-#include "VirtualScreen.h"
-#include "PaletteColors.h"
+#include "FrameBuffer.h"
+#include "SaveState.h"
 
 namespace sn
 {
@@ -17,14 +18,30 @@ namespace sn
 
     const int AttributeOffset = 0x3C0;
 
+    enum RenderMode
+    {
+        DrawPixels,
+        //Registers, scrolling and sprite-0 hits behave the same but frames are not drawn,
+        //the frame buffer keeps the last frame drawn. Switch modes between frames
+        SkipPixels
+    };
+
     class PPU
     {
         public:
-            PPU(PictureBus &bus, VirtualScreen &screen);
+            PPU(PictureBus &bus, FrameBuffer &frameBuffer);
             void step();
             void reset();
 
+            //Catch-up scheduling: steps can be queued instead of run, as long as none of them reaches the start
+            //of vertical blank, where the PPU may interrupt the CPU. Returns false, queuing nothing, otherwise
+            bool deferSteps(int steps);
+            //Runs the queued steps, needed before anything observes or changes the PPU
+            void catchUp();
+
             void setInterruptCallback(std::function<void(void)> cb);
+            void setRenderMode(RenderMode mode);
+            RenderMode getRenderMode() const;
 
             void doDMA(const Byte* page_ptr);
 
@@ -41,12 +58,21 @@ namespace sn
             Byte getData();
             Byte getOAMData();
             void setOAMData(Byte value);
+
+            void saveState(StateWriter& writer) const;
+            bool loadState(StateReader& reader);
         private:
             Byte readOAM(Byte addr);
             void writeOAM(Byte addr, Byte value);
             Byte read(Address addr);
+            //The visible dots of the current scanline at once, same result as stepping through them
+            void renderScanline();
+            //Whether the current scanline can still set the sprite-0 hit flag
+            bool canHitSpriteZero() const;
+            //Lower bound on the steps that can run before the one that starts vertical blank
+            int getStepsToVBlank() const;
             PictureBus &m_bus;
-            VirtualScreen &m_screen;
+            FrameBuffer &m_frameBuffer;
 
             std::function<void(void)> m_vblankCallback;
 
@@ -54,6 +80,8 @@ namespace sn
 
             std::vector<Byte> m_scanlineSprites;
 
+            RenderMode m_renderMode;
+
             enum State
             {
                 PreRender,
@@ -64,6 +92,7 @@ namespace sn
             int m_cycle;
             int m_scanline;
             bool m_evenFrame;
+            int m_pendingSteps;
 
             bool m_vblank;
             bool m_sprZeroHit;
@@ -95,8 +124,6 @@ namespace sn
               m_sprPage;
 
             Address m_dataAddrIncrement;
-
-            std::vector<std::vector<sf::Color>> m_pictureBuffer;
     };
 }
 
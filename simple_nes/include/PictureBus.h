@@ -3,6 +3,7 @@
 #include <vector>
 #include "Cartridge.h"
 #include "Mapper.h"
+#include "SaveState.h"
 
 namespace sn
 {
@@ -17,6 +18,9 @@ namespace sn
             Byte readPalette(Byte paletteAddr);
 
             void updateMirroring();
+
+            void saveState(StateWriter& writer) const;
+            bool loadState(StateReader& reader);
         private:
             std::vector<Byte> m_RAM;
             std::size_t NameTable0, NameTable1, NameTable2, NameTable3; //indices where they start in RAM vector
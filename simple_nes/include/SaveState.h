@@ -0,0 +1,80 @@
+#ifndef SAVESTATE_H
+#define SAVESTATE_H
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace sn
+{
+    using Byte = std::uint8_t;
+
+    //A snapshot of the whole machine, only valid for the cartridge it was taken with
+    struct SaveState
+    {
+        std::vector<Byte> data;
+    };
+
+    class StateWriter
+    {
+        public:
+            StateWriter(SaveState& state) : m_state(state) {};
+
+            template<typename T>
+            void write(const T& value)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "StateWriter can only write trivially copyable values");
+                writeBytes(reinterpret_cast<const Byte*>(&value), sizeof(T));
+            }
+
+            template<typename T>
+            void write(const std::vector<T>& values)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "StateWriter can only write trivially copyable values");
+                write<std::uint64_t>(values.size());
+                writeBytes(reinterpret_cast<const Byte*>(values.data()), values.size() * sizeof(T));
+            }
+
+            void writeBytes(const Byte* bytes, std::size_t size);
+        private:
+            SaveState& m_state;
+    };
+
+    //Reads back what a StateWriter wrote, in the same order. Any mismatch makes the reader bad and every later read fail
+    class StateReader
+    {
+        public:
+            StateReader(const SaveState& state) : m_state(state), m_position(0), m_good(true) {};
+
+            template<typename T>
+            bool read(T& value)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "StateReader can only read trivially copyable values");
+                return readBytes(reinterpret_cast<Byte*>(&value), sizeof(T));
+            }
+
+            //The vector must already have the size that was written, states never resize the machine
+            template<typename T>
+            bool read(std::vector<T>& values)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "StateReader can only read trivially copyable values");
+                std::uint64_t size = 0;
+                if (!read(size) || size != values.size())
+                    return m_good = false;
+                return readBytes(reinterpret_cast<Byte*>(values.data()), values.size() * sizeof(T));
+            }
+
+            bool readBytes(Byte* bytes, std::size_t size);
+            //Points into the state instead of copying, nullptr on failure
+            const Byte* readView(std::size_t size);
+
+            bool good() const { return m_good; }
+            bool atEnd() const { return m_position == m_state.data.size(); }
+        private:
+            const SaveState& m_state;
+            std::size_t m_position;
+            bool m_good;
+    };
+}
+
+#endif // SAVESTATE_H
@@ -2,31 +2,31 @@
 #define VIRTUALSCREEN_H
 #include <memory>
 #include <SFML/Graphics.hpp>
+#include "FrameBuffer.h"
 
 namespace sn
 {
+    //Draws a frame buffer, converting it to RGB only when drawn
     class VirtualScreen : public sf::Drawable
     {
     public:
-        void create (unsigned int width = 256, unsigned int height = 240, float pixel_size = 2.f, sf::Color color = sf::Color::Magenta);
-        void setPixel (std::size_t x, std::size_t y, sf::Color color);
+        void create (unsigned int width = 256, unsigned int height = 240, float pixel_size = 2.f);
 
-        std::shared_ptr<sf::Image> getScreenData() const;
-        std::shared_ptr<sf::Image> flushScreenData();
+        std::shared_ptr<const FrameBuffer> getScreenData() const;
 
         void setScreenPosition( sf::Vector2f pos );
 
-        void setScreenData( std::shared_ptr<sf::Image> data );
+        void setScreenData( std::shared_ptr<const FrameBuffer> data );
 
         sf::Vector2u screenSize() const;
 
     private:
         void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
-        std::shared_ptr<sf::Image> m_pixelColors;
+        std::shared_ptr<const FrameBuffer> m_frameBuffer;
+        mutable std::vector<sf::Uint8> m_pixels;
         mutable sf::Texture m_texture;
         mutable sf::Sprite m_sprite;
-        sf::Color m_defaultColor;
         sf::Vector2u m_screenSize;
     };
 }
@@ -1,4 +1,5 @@
-#include "Emulator.h"
+#include "EmulatorWindow.h"
+#include "CPUTrace.h"
 #include "Log.h"
 #include <string>
 #include <sstream>
@@ -22,14 +23,14 @@ int main(int argc, char** argv)
 
     sn::Log::get().setLevel(sn::Info);
 
-    std::string path;
+    std::string path, cpuTracePath;
 
     //Default keybindings
     std::vector<sf::Keyboard::Key> p1 {sf::Keyboard::J, sf::Keyboard::K, sf::Keyboard::RShift, sf::Keyboard::Return,
                                        sf::Keyboard::W, sf::Keyboard::S, sf::Keyboard::A, sf::Keyboard::D},
                                    p2 {sf::Keyboard::Numpad5, sf::Keyboard::Numpad6, sf::Keyboard::Numpad8, sf::Keyboard::Numpad9,
                                        sf::Keyboard::Up, sf::Keyboard::Down, sf::Keyboard::Left, sf::Keyboard::Right};
-    sn::Emulator emulator;
+    sn::EmulatorWindow emulator;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -49,6 +50,8 @@ int main(int argc, char** argv)
                       << "-H, --height           Set the height of the emulation screen (width is\n"
                       << "                       set automatically to fit the aspect ratio)\n"
                       << "                       This option is mutually exclusive to --width\n"
+                      << "--check-cpu-trace      Run the ROM from $C000 without a window and compare\n"
+                      << "                       every instruction with a trace like nestest.log\n"
                       << std::endl;
             return 0;
         }
@@ -59,6 +62,13 @@ int main(int argc, char** argv)
             sn::Log::get().setCpuTraceStream(cpuTraceFile);
             LOG(sn::Info) << "CPU logging set." << std::endl;
         }
+        else if (std::strcmp(argv[i], "--check-cpu-trace") == 0)
+        {
+            if (i + 1 < argc)
+                cpuTracePath = argv[++i];
+            else
+                LOG(sn::Error) << "CPU trace path required" << std::endl;
+        }
         else if (std::strcmp(argv[i], "-s") == 0 || std::strcmp(argv[i], "--scale") == 0)
         {
             float scale;
@@ -101,6 +111,19 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    if (!cpuTracePath.empty())
+    {
+        std::ifstream trace (cpuTracePath);
+        sn::Emulator core;
+        if (!trace || !core.init(path))
+        {
+            LOG(sn::Error) << "Could not open " << cpuTracePath << " or " << path << std::endl;
+            return 1;
+        }
+        core.resetCPU(0xc000);
+        return sn::checkCPUTrace(core, trace) ? 0 : 1;
+    }
+
     sn::parseControllerConf("keybindings.conf", p1, p2);
     emulator.setKeys(p1, p2);
     emulator.run(path);
@@ -100,6 +100,19 @@ namespace sn
 
         m_skipCycles = 0;
 
+        execute();
+    }
+
+    void CPU::executeNext()
+    {
+        m_cycles += getCyclesToNextInstruction() + 1;
+        m_skipCycles = 0;
+
+        execute();
+    }
+
+    void CPU::execute()
+    {
         int psw =    f_N << 7 |
                      f_V << 6 |
                        1 << 5 |
@@ -122,26 +135,23 @@ namespace sn
 
         Byte opcode = m_bus.read(r_PC++);
 
-        auto CycleLength = OperationCycles[opcode];
+        const Instruction& instruction = m_instructions[opcode];
+        (this->*instruction.execute)();
+        m_skipCycles += instruction.cycles;
+        //m_cycles %= 340; //compatibility with Nintendulator log
+        //m_skipCycles = 0; //for TESTING
+    }
 
-        //Using short-circuit evaluation, call the other function only if the first failed
-        //ExecuteImplied must be called first and ExecuteBranch must be before ExecuteType0
-        if (CycleLength && (executeImplied(opcode) || executeBranch(opcode) ||
-                        executeType1(opcode) || executeType2(opcode) || executeType0(opcode)))
-        {
-            m_skipCycles += CycleLength;
-            //m_cycles %= 340; //compatibility with Nintendulator log
-            //m_skipCycles = 0; //for TESTING
-        }
-        else
-        {
-            LOG(Error) << "Unrecognized opcode: " << std::hex << +opcode << std::endl;
-        }
+    template <Byte Opcode>
+    void CPU::executeUnused()
+    {
+        LOG(Error) << "Unrecognized opcode: " << std::hex << +Opcode << std::endl;
     }
 
-    bool CPU::executeImplied(Byte opcode)
+    template <OperationImplied Op>
+    void CPU::executeImplied()
     {
-        switch (static_cast<OperationImplied>(opcode))
+        switch (Op)
         {
             case NOP:
                 break;
@@ -278,372 +288,434 @@ namespace sn
                 r_X = r_SP;
                 setZN(r_X);
                 break;
-            default:
-                return false;
         };
-        return true;
     }
 
-    bool CPU::executeBranch(Byte opcode)
+    template <BranchOnFlag Flag, bool Condition>
+    void CPU::executeBranch()
     {
-        if ((opcode & BranchInstructionMask) == BranchInstructionMaskResult)
+        //branch is initialized to the condition required (for the flag specified later)
+        bool branch = Condition;
+
+        //set branch to true if the given condition is met by the given flag
+        //We use xnor here, it is true if either both operands are true or false
+        switch (Flag)
         {
-            //branch is initialized to the condition required (for the flag specified later)
-            bool branch = opcode & BranchConditionMask;
-
-            //set branch to true if the given condition is met by the given flag
-            //We use xnor here, it is true if either both operands are true or false
-            switch (opcode >> BranchOnFlagShift)
-            {
-                case Negative:
-                    branch = !(branch ^ f_N);
-                    break;
-                case Overflow:
-                    branch = !(branch ^ f_V);
-                    break;
-                case Carry:
-                    branch = !(branch ^ f_C);
-                    break;
-                case Zero:
-                    branch = !(branch ^ f_Z);
-                    break;
-                default:
-                    return false;
-            }
-
-            if (branch)
-            {
-                int8_t offset = m_bus.read(r_PC++);
-                ++m_skipCycles;
-                auto newPC = static_cast<Address>(r_PC + offset);
-                setPageCrossed(r_PC, newPC, 2);
-                r_PC = newPC;
-            }
-            else
-                ++r_PC;
-            return true;
+            case Negative:
+                branch = !(branch ^ f_N);
+                break;
+            case Overflow:
+                branch = !(branch ^ f_V);
+                break;
+            case Carry:
+                branch = !(branch ^ f_C);
+                break;
+            case Zero:
+                branch = !(branch ^ f_Z);
+                break;
+        }
+
+        if (branch)
+        {
+            int8_t offset = m_bus.read(r_PC++);
+            ++m_skipCycles;
+            auto newPC = static_cast<Address>(r_PC + offset);
+            setPageCrossed(r_PC, newPC, 2);
+            r_PC = newPC;
         }
-        return false;
+        else
+            ++r_PC;
     }
 
-    bool CPU::executeType1(Byte opcode)
+    template <Operation1 Op, AddrMode1 Mode>
+    void CPU::executeType1()
     {
-        if ((opcode & InstructionModeMask) == 0x1)
+        Address location = 0; //Location of the operand, could be in RAM
+        switch (Mode)
         {
-            Address location = 0; //Location of the operand, could be in RAM
-            auto op = static_cast<Operation1>((opcode & OperationMask) >> OperationShift);
-            switch (static_cast<AddrMode1>(
-                    (opcode & AddrModeMask) >> AddrModeShift))
-            {
-                case IndexedIndirectX:
-                    {
-                        Byte zero_addr = r_X + m_bus.read(r_PC++);
-                        //Addresses wrap in zero page mode, thus pass through a mask
-                        location = m_bus.read(zero_addr & 0xff) | m_bus.read((zero_addr + 1) & 0xff) << 8;
-                    }
-                    break;
-                case ZeroPage:
-                    location = m_bus.read(r_PC++);
-                    break;
-                case Immediate:
-                    location = r_PC++;
-                    break;
-                case Absolute:
-                    location = readAddress(r_PC);
-                    r_PC += 2;
-                    break;
-                case IndirectY:
-                    {
-                        Byte zero_addr = m_bus.read(r_PC++);
-                        location = m_bus.read(zero_addr & 0xff) | m_bus.read((zero_addr + 1) & 0xff) << 8;
-                        if (op != STA)
-                            setPageCrossed(location, location + r_Y);
-                        location += r_Y;
-                    }
-                    break;
-                case IndexedX:
-                    // Address wraps around in the zero page
-                    location = (m_bus.read(r_PC++) + r_X) & 0xff;
-                    break;
-                case AbsoluteY:
-                    location = readAddress(r_PC);
-                    r_PC += 2;
-                    if (op != STA)
+            case IndexedIndirectX:
+                {
+                    Byte zero_addr = r_X + m_bus.read(r_PC++);
+                    //Addresses wrap in zero page mode, thus pass through a mask
+                    location = m_bus.read(zero_addr & 0xff) | m_bus.read((zero_addr + 1) & 0xff) << 8;
+                }
+                break;
+            case ZeroPage:
+                location = m_bus.read(r_PC++);
+                break;
+            case Immediate:
+                location = r_PC++;
+                break;
+            case Absolute:
+                location = readAddress(r_PC);
+                r_PC += 2;
+                break;
+            case IndirectY:
+                {
+                    Byte zero_addr = m_bus.read(r_PC++);
+                    location = m_bus.read(zero_addr & 0xff) | m_bus.read((zero_addr + 1) & 0xff) << 8;
+                    if (Op != STA)
                         setPageCrossed(location, location + r_Y);
                     location += r_Y;
-                    break;
-                case AbsoluteX:
-                    location = readAddress(r_PC);
-                    r_PC += 2;
-                    if (op != STA)
-                        setPageCrossed(location, location + r_X);
-                    location += r_X;
-                    break;
-                default:
-                    return false;
-            }
-
-            switch (op)
-            {
-                case ORA:
-                    r_A |= m_bus.read(location);
-                    setZN(r_A);
-                    break;
-                case AND:
-                    r_A &= m_bus.read(location);
-                    setZN(r_A);
-                    break;
-                case EOR:
-                    r_A ^= m_bus.read(location);
-                    setZN(r_A);
-                    break;
-                case ADC:
-                    {
-                        Byte operand = m_bus.read(location);
-                        std::uint16_t sum = r_A + operand + f_C;
-                        //Carry forward or UNSIGNED overflow
-                        f_C = sum & 0x100;
-                        //SIGNED overflow, would only happen if the sign of sum is
-                        //different from BOTH the operands
-                        f_V = (r_A ^ sum) & (operand ^ sum) & 0x80;
-                        r_A = static_cast<Byte>(sum);
-                        setZN(r_A);
-                    }
-                    break;
-                case STA:
-                    m_bus.write(location, r_A);
-                    break;
-                case LDA:
-                    r_A = m_bus.read(location);
+                }
+                break;
+            case IndexedX:
+                // Address wraps around in the zero page
+                location = (m_bus.read(r_PC++) + r_X) & 0xff;
+                break;
+            case AbsoluteY:
+                location = readAddress(r_PC);
+                r_PC += 2;
+                if (Op != STA)
+                    setPageCrossed(location, location + r_Y);
+                location += r_Y;
+                break;
+            case AbsoluteX:
+                location = readAddress(r_PC);
+                r_PC += 2;
+                if (Op != STA)
+                    setPageCrossed(location, location + r_X);
+                location += r_X;
+                break;
+        }
+
+        switch (Op)
+        {
+            case ORA:
+                r_A |= m_bus.read(location);
+                setZN(r_A);
+                break;
+            case AND:
+                r_A &= m_bus.read(location);
+                setZN(r_A);
+                break;
+            case EOR:
+                r_A ^= m_bus.read(location);
+                setZN(r_A);
+                break;
+            case ADC:
+                {
+                    Byte operand = m_bus.read(location);
+                    std::uint16_t sum = r_A + operand + f_C;
+                    //Carry forward or UNSIGNED overflow
+                    f_C = sum & 0x100;
+                    //SIGNED overflow, would only happen if the sign of sum is
+                    //different from BOTH the operands
+                    f_V = (r_A ^ sum) & (operand ^ sum) & 0x80;
+                    r_A = static_cast<Byte>(sum);
                     setZN(r_A);
-                    break;
-                case SBC:
-                    {
-                        //High carry means "no borrow", thus negate and subtract
-                        std::uint16_t subtrahend = m_bus.read(location),
-                                 diff = r_A - subtrahend - !f_C;
-                        //if the ninth bit is 1, the resulting number is negative => borrow => low carry
-                        f_C = !(diff & 0x100);
-                        //Same as ADC, except instead of the subtrahend,
-                        //substitute with it's one complement
-                        f_V = (r_A ^ diff) & (~subtrahend ^ diff) & 0x80;
-                        r_A = diff;
-                        setZN(diff);
-                    }
-                    break;
-                case CMP:
-                    {
-                        std::uint16_t diff = r_A - m_bus.read(location);
-                        f_C = !(diff & 0x100);
-                        setZN(diff);
-                    }
-                    break;
-                default:
-                    return false;
-            }
-            return true;
+                }
+                break;
+            case STA:
+                m_bus.write(location, r_A);
+                break;
+            case LDA:
+                r_A = m_bus.read(location);
+                setZN(r_A);
+                break;
+            case SBC:
+                {
+                    //High carry means "no borrow", thus negate and subtract
+                    std::uint16_t subtrahend = m_bus.read(location),
+                             diff = r_A - subtrahend - !f_C;
+                    //if the ninth bit is 1, the resulting number is negative => borrow => low carry
+                    f_C = !(diff & 0x100);
+                    //Same as ADC, except instead of the subtrahend,
+                    //substitute with it's one complement
+                    f_V = (r_A ^ diff) & (~subtrahend ^ diff) & 0x80;
+                    r_A = diff;
+                    setZN(diff);
+                }
+                break;
+            case CMP:
+                {
+                    std::uint16_t diff = r_A - m_bus.read(location);
+                    f_C = !(diff & 0x100);
+                    setZN(diff);
+                }
+                break;
         }
-        return false;
     }
 
-    bool CPU::executeType2(Byte opcode)
+    template <Operation2 Op, AddrMode2 Mode>
+    void CPU::executeType2()
     {
-        if ((opcode & InstructionModeMask) == 2)
+        Address location = 0;
+        switch (Mode)
         {
-            Address location = 0;
-            auto op = static_cast<Operation2>((opcode & OperationMask) >> OperationShift);
-            auto addr_mode =
-                    static_cast<AddrMode2>((opcode & AddrModeMask) >> AddrModeShift);
-            switch (addr_mode)
-            {
-                case Immediate_:
-                    location = r_PC++;
-                    break;
-                case ZeroPage_:
+            case Immediate_:
+                location = r_PC++;
+                break;
+            case ZeroPage_:
+                location = m_bus.read(r_PC++);
+                break;
+            case Accumulator:
+                break;
+            case Absolute_:
+                location = readAddress(r_PC);
+                r_PC += 2;
+                break;
+            case Indexed:
+                {
                     location = m_bus.read(r_PC++);
-                    break;
-                case Accumulator:
-                    break;
-                case Absolute_:
+                    Byte index;
+                    if (Op == LDX || Op == STX)
+                        index = r_Y;
+                    else
+                        index = r_X;
+                    //The mask wraps address around zero page
+                    location = (location + index) & 0xff;
+                }
+                break;
+            case AbsoluteIndexed:
+                {
                     location = readAddress(r_PC);
                     r_PC += 2;
-                    break;
-                case Indexed:
-                    {
-                        location = m_bus.read(r_PC++);
-                        Byte index;
-                        if (op == LDX || op == STX)
-                            index = r_Y;
-                        else
-                            index = r_X;
-                        //The mask wraps address around zero page
-                        location = (location + index) & 0xff;
-                    }
-                    break;
-                case AbsoluteIndexed:
-                    {
-                        location = readAddress(r_PC);
-                        r_PC += 2;
-                        Byte index;
-                        if (op == LDX || op == STX)
-                            index = r_Y;
-                        else
-                            index = r_X;
-                        setPageCrossed(location, location + index);
-                        location += index;
-                    }
-                    break;
-                default:
-                    return false;
-            }
-
-            std::uint16_t operand = 0;
-            switch (op)
-            {
-                case ASL:
-                case ROL:
-                    if (addr_mode == Accumulator)
-                    {
-                        auto prev_C = f_C;
-                        f_C = r_A & 0x80;
-                        r_A <<= 1;
-                        //If Rotating, set the bit-0 to the the previous carry
-                        r_A = r_A | (prev_C && (op == ROL));
-                        setZN(r_A);
-                    }
-                    else
-                    {
-                        auto prev_C = f_C;
-                        operand = m_bus.read(location);
-                        f_C = operand & 0x80;
-                        operand = operand << 1 | (prev_C && (op == ROL));
-                        setZN(operand);
-                        m_bus.write(location, operand);
-                    }
-                    break;
-                case LSR:
-                case ROR:
-                    if (addr_mode == Accumulator)
-                    {
-                        auto prev_C = f_C;
-                        f_C = r_A & 1;
-                        r_A >>= 1;
-                        //If Rotating, set the bit-7 to the previous carry
-                        r_A = r_A | (prev_C && (op == ROR)) << 7;
-                        setZN(r_A);
-                    }
+                    Byte index;
+                    if (Op == LDX || Op == STX)
+                        index = r_Y;
                     else
-                    {
-                        auto prev_C = f_C;
-                        operand = m_bus.read(location);
-                        f_C = operand & 1;
-                        operand = operand >> 1 | (prev_C && (op == ROR)) << 7;
-                        setZN(operand);
-                        m_bus.write(location, operand);
-                    }
-                    break;
-                case STX:
-                    m_bus.write(location, r_X);
-                    break;
-                case LDX:
-                    r_X = m_bus.read(location);
-                    setZN(r_X);
-                    break;
-                case DEC:
-                    {
-                        auto tmp = m_bus.read(location) - 1;
-                        setZN(tmp);
-                        m_bus.write(location, tmp);
-                    }
-                    break;
-                case INC:
-                    {
-                        auto tmp = m_bus.read(location) + 1;
-                        setZN(tmp);
-                        m_bus.write(location, tmp);
-                    }
-                    break;
-                default:
-                    return false;
-            }
-            return true;
+                        index = r_X;
+                    setPageCrossed(location, location + index);
+                    location += index;
+                }
+                break;
+        }
+
+        std::uint16_t operand = 0;
+        switch (Op)
+        {
+            case ASL:
+            case ROL:
+                if (Mode == Accumulator)
+                {
+                    auto prev_C = f_C;
+                    f_C = r_A & 0x80;
+                    r_A <<= 1;
+                    //If Rotating, set the bit-0 to the the previous carry
+                    r_A = r_A | (prev_C && (Op == ROL));
+                    setZN(r_A);
+                }
+                else
+                {
+                    auto prev_C = f_C;
+                    operand = m_bus.read(location);
+                    f_C = operand & 0x80;
+                    operand = operand << 1 | (prev_C && (Op == ROL));
+                    setZN(operand);
+                    m_bus.write(location, operand);
+                }
+                break;
+            case LSR:
+            case ROR:
+                if (Mode == Accumulator)
+                {
+                    auto prev_C = f_C;
+                    f_C = r_A & 1;
+                    r_A >>= 1;
+                    //If Rotating, set the bit-7 to the previous carry
+                    r_A = r_A | (prev_C && (Op == ROR)) << 7;
+                    setZN(r_A);
+                }
+                else
+                {
+                    auto prev_C = f_C;
+                    operand = m_bus.read(location);
+                    f_C = operand & 1;
+                    operand = operand >> 1 | (prev_C && (Op == ROR)) << 7;
+                    setZN(operand);
+                    m_bus.write(location, operand);
+                }
+                break;
+            case STX:
+                m_bus.write(location, r_X);
+                break;
+            case LDX:
+                r_X = m_bus.read(location);
+                setZN(r_X);
+                break;
+            case DEC:
+                {
+                    auto tmp = m_bus.read(location) - 1;
+                    setZN(tmp);
+                    m_bus.write(location, tmp);
+                }
+                break;
+            case INC:
+                {
+                    auto tmp = m_bus.read(location) + 1;
+                    setZN(tmp);
+                    m_bus.write(location, tmp);
+                }
+                break;
         }
-        return false;
     }
 
-    bool CPU::executeType0(Byte opcode)
+    template <Operation0 Op, AddrMode2 Mode>
+    void CPU::executeType0()
     {
-        if ((opcode & InstructionModeMask) == 0x0)
+        Address location = 0;
+        switch (Mode)
         {
-            Address location = 0;
-            switch (static_cast<AddrMode2>((opcode & AddrModeMask) >> AddrModeShift))
-            {
-                case Immediate_:
-                    location = r_PC++;
-                    break;
-                case ZeroPage_:
-                    location = m_bus.read(r_PC++);
-                    break;
-                case Absolute_:
-                    location = readAddress(r_PC);
-                    r_PC += 2;
-                    break;
-                case Indexed:
-                    // Address wraps around in the zero page
-                    location = (m_bus.read(r_PC++) + r_X) & 0xff;
-                    break;
-                case AbsoluteIndexed:
-                    location = readAddress(r_PC);
-                    r_PC += 2;
-                    setPageCrossed(location, location + r_X);
-                    location += r_X;
-                    break;
-                default:
-                    return false;
-            }
-            std::uint16_t operand = 0;
-            switch (static_cast<Operation0>((opcode & OperationMask) >> OperationShift))
-            {
-                case BIT:
-                    operand = m_bus.read(location);
-                    f_Z = !(r_A & operand);
-                    f_V = operand & 0x40;
-                    f_N = operand & 0x80;
-                    break;
-                case STY:
-                    m_bus.write(location, r_Y);
-                    break;
-                case LDY:
-                    r_Y = m_bus.read(location);
-                    setZN(r_Y);
-                    break;
-                case CPY:
-                    {
-                        std::uint16_t diff = r_Y - m_bus.read(location);
-                        f_C = !(diff & 0x100);
-                        setZN(diff);
-                    }
-                    break;
-                case CPX:
-                    {
-                        std::uint16_t diff = r_X - m_bus.read(location);
-                        f_C = !(diff & 0x100);
-                        setZN(diff);
-                    }
-                    break;
-                default:
-                    return false;
-            }
-
-            return true;
+            case Immediate_:
+                location = r_PC++;
+                break;
+            case ZeroPage_:
+                location = m_bus.read(r_PC++);
+                break;
+            case Absolute_:
+                location = readAddress(r_PC);
+                r_PC += 2;
+                break;
+            case Indexed:
+                // Address wraps around in the zero page
+                location = (m_bus.read(r_PC++) + r_X) & 0xff;
+                break;
+            case AbsoluteIndexed:
+                location = readAddress(r_PC);
+                r_PC += 2;
+                setPageCrossed(location, location + r_X);
+                location += r_X;
+                break;
+            default:
+                break;
+        }
+        std::uint16_t operand = 0;
+        switch (Op)
+        {
+            case BIT:
+                operand = m_bus.read(location);
+                f_Z = !(r_A & operand);
+                f_V = operand & 0x40;
+                f_N = operand & 0x80;
+                break;
+            case STY:
+                m_bus.write(location, r_Y);
+                break;
+            case LDY:
+                r_Y = m_bus.read(location);
+                setZN(r_Y);
+                break;
+            case CPY:
+                {
+                    std::uint16_t diff = r_Y - m_bus.read(location);
+                    f_C = !(diff & 0x100);
+                    setZN(diff);
+                }
+                break;
+            case CPX:
+                {
+                    std::uint16_t diff = r_X - m_bus.read(location);
+                    f_C = !(diff & 0x100);
+                    setZN(diff);
+                }
+                break;
         }
-        return false;
     }
 
+    template <Byte Opcode>
+    struct CPU::Decode<Opcode, ImpliedSet>
+    {
+        static constexpr Instruction get() { return { &CPU::executeImplied<static_cast<OperationImplied>(Opcode)>, OperationCycles[Opcode] }; }
+    };
+
+    template <Byte Opcode>
+    struct CPU::Decode<Opcode, BranchSet>
+    {
+        static constexpr Instruction get()
+        {
+            return { &CPU::executeBranch<static_cast<BranchOnFlag>(Opcode >> BranchOnFlagShift), (Opcode & BranchConditionMask) != 0>,
+                     OperationCycles[Opcode] };
+        }
+    };
+
+    template <Byte Opcode>
+    struct CPU::Decode<Opcode, Type1Set>
+    {
+        static constexpr Instruction get()
+        {
+            return { &CPU::executeType1<static_cast<Operation1>(getOperation(Opcode)), static_cast<AddrMode1>(getAddrMode(Opcode))>,
+                     OperationCycles[Opcode] };
+        }
+    };
+
+    template <Byte Opcode>
+    struct CPU::Decode<Opcode, Type2Set>
+    {
+        static constexpr Instruction get()
+        {
+            return { &CPU::executeType2<static_cast<Operation2>(getOperation(Opcode)), static_cast<AddrMode2>(getAddrMode(Opcode))>,
+                     OperationCycles[Opcode] };
+        }
+    };
+
+    template <Byte Opcode>
+    struct CPU::Decode<Opcode, Type0Set>
+    {
+        static constexpr Instruction get()
+        {
+            return { &CPU::executeType0<static_cast<Operation0>(getOperation(Opcode)), static_cast<AddrMode2>(getAddrMode(Opcode))>,
+                     OperationCycles[Opcode] };
+        }
+    };
+
+    //Takes no cycles, the next instruction is fetched on the next cycle
+    template <Byte Opcode>
+    struct CPU::Decode<Opcode, UnusedSet>
+    {
+        static constexpr Instruction get() { return { &CPU::executeUnused<Opcode>, 0 }; }
+    };
+
+    template <std::size_t... Opcodes>
+    constexpr std::array<CPU::Instruction, 0x100> CPU::makeInstructionTable(std::index_sequence<Opcodes...>)
+    {
+        return {{ Decode<Opcodes>::get()... }};
+    }
+
+    const std::array<CPU::Instruction, 0x100> CPU::m_instructions = makeInstructionTable(std::make_index_sequence<0x100>());
+
     Address CPU::readAddress(Address addr)
     {
         return m_bus.read(addr) | m_bus.read(addr + 1) << 8;
     }
 
-}
+    void CPU::saveState(StateWriter& writer) const
+    {
+        writer.write(m_skipCycles);
+        writer.write(m_cycles);
+
+        writer.write(r_PC);
+        writer.write(r_SP);
+        writer.write(r_A);
+        writer.write(r_X);
+        writer.write(r_Y);
+
+        writer.write(f_C);
+        writer.write(f_Z);
+        writer.write(f_I);
+        writer.write(f_D);
+        writer.write(f_V);
+        writer.write(f_N);
+    }
 
+    bool CPU::loadState(StateReader& reader)
+    {
+        reader.read(m_skipCycles);
+        reader.read(m_cycles);
+
+        reader.read(r_PC);
+        reader.read(r_SP);
+        reader.read(r_A);
+        reader.read(r_X);
+        reader.read(r_Y);
+
+        reader.read(f_C);
+        reader.read(f_Z);
+        reader.read(f_I);
+        reader.read(f_D);
+        reader.read(f_V);
+        reader.read(f_N);
+
+        return reader.good();
+    }
+}
@@ -0,0 +1,113 @@
+#include "CPUTrace.h"
+#include "Log.h"
+#include <cstring>
+#include <sstream>
+
+namespace sn
+{
+    namespace
+    {
+        bool readField(const std::string& line, const char* name, int& value, bool hex = true)
+        {
+            auto pos = line.find(name);
+            if (pos == std::string::npos)
+                return false;
+
+            std::istringstream ss(line.substr(pos + std::strlen(name)));
+            if (hex)
+                ss >> std::hex;
+            return static_cast<bool>(ss >> value);
+        }
+
+        //PPU dots from one line to the next, the older logs only keep the dot of the scanline
+        int dotsBetween(const CPUTraceLine& from, const CPUTraceLine& to)
+        {
+            int dots = to.cpuCycles ? (to.cycle - from.cycle) * 3 : to.cycle - from.cycle;
+            return ((dots % 341) + 341) % 341;
+        }
+    }
+
+    bool parseCPUTraceLine(const std::string& line, CPUTraceLine& out)
+    {
+        int pc, opcode, a, x, y, p, sp, cycle;
+
+        std::istringstream ss(line);
+        if (!(ss >> std::hex >> pc >> opcode))
+            return false;
+
+        //The spaces keep "P:" from matching "SP:"
+        if (!readField(line, " A:", a) || !readField(line, " X:", x) || !readField(line, " Y:", y) ||
+            !readField(line, " P:", p) || !readField(line, "SP:", sp) || !readField(line, "CYC:", cycle, false))
+            return false;
+
+        out.pc = pc;
+        out.opcode = opcode;
+        out.a = a;
+        out.x = x;
+        out.y = y;
+        out.p = p;
+        out.sp = sp;
+        out.cycle = cycle;
+        out.cpuCycles = line.find("PPU:") != std::string::npos;
+        return true;
+    }
+
+    bool checkCPUTrace(Emulator& emulator, std::istream& trace)
+    {
+        Log& log = Log::get();
+        const Level level = log.getLevel();
+        std::ostream& traceStream = log.getCpuTraceStream();
+
+        std::ostringstream executed;
+        log.setCpuTraceStream(executed);
+        log.setLevel(CpuTrace);
+
+        std::string expectedLine, executedLine;
+        CPUTraceLine expected {}, actual {}, lastExpected {}, lastActual {};
+        std::size_t lines = 0;
+        bool matched = true;
+
+        while (std::getline(trace, expectedLine))
+        {
+            if (!expectedLine.empty() && expectedLine.back() == '\r')
+                expectedLine.pop_back();
+            if (expectedLine.empty())
+                continue;
+
+            ++lines;
+
+            //CPU::execute writes one line to the trace for every instruction
+            executed.str("");
+            while (executed.tellp() == 0)
+                emulator.step();
+
+            executedLine = executed.str();
+            executedLine.pop_back();
+
+            if (!parseCPUTraceLine(expectedLine, expected) || !parseCPUTraceLine(executedLine, actual) ||
+                expected.pc != actual.pc || expected.opcode != actual.opcode ||
+                expected.a != actual.a || expected.x != actual.x || expected.y != actual.y ||
+                expected.p != actual.p || expected.sp != actual.sp ||
+                (lines > 1 && dotsBetween(lastExpected, expected) != dotsBetween(lastActual, actual)))
+            {
+                matched = false;
+                break;
+            }
+
+            lastExpected = expected;
+            lastActual = actual;
+        }
+
+        log.setCpuTraceStream(traceStream);
+        log.setLevel(level);
+
+        if (!matched)
+            LOG(Error) << "CPU trace differs at line " << lines << std::endl
+                       << "expected: " << expectedLine << std::endl
+                       << "executed: " << executedLine << std::endl;
+        else
+            LOG(Info) << "CPU trace matched all " << lines << " lines" << std::endl;
+
+        return matched;
+    }
+}
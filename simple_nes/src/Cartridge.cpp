@@ -2,41 +2,50 @@
 #include "Log.h"
 #include <fstream>
 #include <string>
+#include <functional>
 
 namespace sn
 {
     Cartridge::Cartridge() :
+        m_PRG_ROM(std::make_shared<const std::vector<Byte>>()),
+        m_CHR_ROM(std::make_shared<const std::vector<Byte>>()),
+        m_hash(0),
         m_nameTableMirroring(0),
         m_mapperNumber(0),
         m_extendedRAM(false)
     {
 
     }
-    const std::vector<Byte>& Cartridge::getROM()
+    const std::vector<Byte>& Cartridge::getROM() const
     {
-        return m_PRG_ROM;
+        return *m_PRG_ROM;
     }
 
-    const std::vector<Byte>& Cartridge::getVROM()
+    const std::vector<Byte>& Cartridge::getVROM() const
     {
-        return m_CHR_ROM;
+        return *m_CHR_ROM;
     }
 
-    Byte Cartridge::getMapper()
+    Byte Cartridge::getMapper() const
     {
         return m_mapperNumber;
     }
 
-    Byte Cartridge::getNameTableMirroring()
+    Byte Cartridge::getNameTableMirroring() const
     {
         return m_nameTableMirroring;
     }
 
-    bool Cartridge::hasExtendedRAM()
+    bool Cartridge::hasExtendedRAM() const
     {
         return m_extendedRAM;
     }
 
+    std::size_t Cartridge::getHash() const
+    {
+        return m_hash;
+    }
+
     bool Cartridge::loadFromFile(std::string path)
     {
         std::ifstream romFile (path, std::ios_base::binary | std::ios_base::in);
@@ -102,18 +111,18 @@ namespace sn
             LOG(Info) << "ROM is NTSC compatible.\n";
 
         //PRG-ROM 16KB banks
-        m_PRG_ROM.resize(0x4000 * banks);
-        if (!romFile.read(reinterpret_cast<char*>(&m_PRG_ROM[0]), 0x4000 * banks))
+        auto prgROM = std::make_shared<std::vector<Byte>>(0x4000 * banks);
+        if (!romFile.read(reinterpret_cast<char*>(&(*prgROM)[0]), 0x4000 * banks))
         {
             LOG(Error) << "Reading PRG-ROM from image file failed." << std::endl;
             return false;
         }
 
         //CHR-ROM 8KB banks
+        auto chrROM = std::make_shared<std::vector<Byte>>(0x2000 * vbanks);
         if (vbanks)
         {
-            m_CHR_ROM.resize(0x2000 * vbanks);
-            if (!romFile.read(reinterpret_cast<char*>(&m_CHR_ROM[0]), 0x2000 * vbanks))
+            if (!romFile.read(reinterpret_cast<char*>(&(*chrROM)[0]), 0x2000 * vbanks))
             {
                 LOG(Error) << "Reading CHR-ROM from image file failed." << std::endl;
                 return false;
@@ -121,6 +130,14 @@ namespace sn
         }
         else
             LOG(Info) << "Cartridge with CHR-RAM." << std::endl;
+
+        std::string image(header.begin(), header.end());
+        image.append(prgROM->begin(), prgROM->end());
+        image.append(chrROM->begin(), chrROM->end());
+        m_hash = std::hash<std::string>{}(image);
+
+        m_PRG_ROM = prgROM;
+        m_CHR_ROM = chrROM;
         return true;
     }
 }
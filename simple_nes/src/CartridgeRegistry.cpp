@@ -0,0 +1,29 @@
+#include "CartridgeRegistry.h"
+
+namespace sn
+{
+    std::mutex CartridgeRegistry::m_mutex;
+    std::map<std::string, std::shared_ptr<const Cartridge>> CartridgeRegistry::m_cartridges;
+
+    std::shared_ptr<const Cartridge> CartridgeRegistry::load(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto found = m_cartridges.find(path);
+        if (found != m_cartridges.end())
+            return found->second;
+
+        auto cartridge = std::make_shared<Cartridge>();
+        if (!cartridge->loadFromFile(path))
+            return nullptr;
+
+        m_cartridges[path] = cartridge;
+        return cartridge;
+    }
+
+    void CartridgeRegistry::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cartridges.clear();
+    }
+}
@@ -3,47 +3,21 @@
 namespace sn
 {
     Controller::Controller() :
+        m_strobe(false),
         m_buttonStates(0),
+        m_useCallbacks(true),
+        m_buttonMask(0),
         m_buttonCallbacks(TotalButtons)
     {
-//         m_keyBindings[A] = sf::Keyboard::J;
-//         m_keyBindings[B] = sf::Keyboard::K;
-//         m_keyBindings[Select] = sf::Keyboard::RShift;
-//         m_keyBindings[Start] = sf::Keyboard::Return;
-//         m_keyBindings[Up] = sf::Keyboard::W;
-//         m_keyBindings[Down] = sf::Keyboard::S;
-//         m_keyBindings[Left] = sf::Keyboard::A;
-//         m_keyBindings[Right] = sf::Keyboard::D;
-
         for (size_t button = A; button < TotalButtons; ++button)
         {
             m_buttonCallbacks[ button ] = [](void) -> bool { return false; };
         }
     }
 
-    void Controller::setKeyBindings(const std::vector<sf::Keyboard::Key>& keys)
-    {
-        //m_keyBindings = keys;
-
-        for (size_t button = A; button < TotalButtons; ++button)
-        {
-            if( button < keys.size() )
-            {
-                m_buttonCallbacks[ button ] = [=](void) -> bool
-                {
-                    return sf::Keyboard::isKeyPressed(keys[button]);
-                };
-            }
-            else
-            {
-                m_buttonCallbacks[ button ] = [](void) -> bool { return false; };
-            }
-
-        }
-    }
-
     void Controller::setCallbacks(const std::vector<std::function<bool(void)>>& callbacks)
     {
+        m_useCallbacks = true;
         m_buttonCallbacks = callbacks;
 
         for( auto& callback : m_buttonCallbacks )
@@ -62,6 +36,7 @@ namespace sn
 
     void Controller::setCallbackMap(const std::map<Buttons,std::function<bool(void)>>& callbacks)
     {
+        m_useCallbacks = true;
         while( m_buttonCallbacks.size() < TotalButtons )
         {
             m_buttonCallbacks.emplace_back( [](void) -> bool { return false; } );
@@ -77,10 +52,18 @@ namespace sn
         }
     }
 
+    void Controller::setButtonStates(Byte buttons)
+    {
+        m_useCallbacks = false;
+        m_buttonMask = buttons;
+    }
+
     void Controller::strobe(Byte b)
     {
         m_strobe = (b & 1);
-        if (!m_strobe)
+        if (!m_strobe && !m_useCallbacks)
+            m_buttonStates = m_buttonMask;
+        else if (!m_strobe)
         {
             m_buttonStates = 0;
             int shift = 0;
@@ -95,7 +78,9 @@ namespace sn
     Byte Controller::read()
     {
         Byte ret;
-        if (m_strobe)
+        if (m_strobe && !m_useCallbacks)
+            ret = (m_buttonMask & 1);
+        else if (m_strobe)
             ret = m_buttonCallbacks[A]();
         else
         {
@@ -105,4 +90,16 @@ namespace sn
         return ret | 0x40;
     }
 
+    void Controller::saveState(StateWriter& writer) const
+    {
+        writer.write(m_strobe);
+        writer.write(m_buttonStates);
+    }
+
+    bool Controller::loadState(StateReader& reader)
+    {
+        reader.read(m_strobe);
+        reader.read(m_buttonStates);
+        return reader.good();
+    }
 }
@@ -1,38 +1,17 @@
 #include "Emulator.h"
 #include "Log.h"
-
-#include <thread>
-#include <chrono>
+#include "CartridgeRegistry.h"
 
 namespace sn
 {
     Emulator::Emulator() :
+        m_frameBuffer(std::make_shared<FrameBuffer>()),
         m_cpu(m_bus),
-        m_ppu(m_pictureBus, m_emulatorScreen),
+        m_ppu(m_pictureBus, *m_frameBuffer),
         m_vblankCounter(0),
-        m_vblankFlag(false),
-        m_screenScale(2.f),
-        m_cpuCycleDuration(std::chrono::nanoseconds(559))
+        m_vblankFlag(false)
     {
-        if(!m_bus.setReadCallback(PPUSTATUS, [&](void) {return m_ppu.getStatus();}) ||
-            !m_bus.setReadCallback(PPUDATA, [&](void) {return m_ppu.getData();}) ||
-            !m_bus.setReadCallback(JOY1, [&](void) {return m_controller1.read();}) ||
-            !m_bus.setReadCallback(JOY2, [&](void) {return m_controller2.read();}) ||
-            !m_bus.setReadCallback(OAMDATA, [&](void) {return m_ppu.getOAMData();}))
-        {
-            LOG(Error) << "Critical error: Failed to set I/O callbacks" << std::endl;
-        }
-
-
-        if(!m_bus.setWriteCallback(PPUCTRL, [&](Byte b) {m_ppu.control(b);}) ||
-            !m_bus.setWriteCallback(PPUMASK, [&](Byte b) {m_ppu.setMask(b);}) ||
-            !m_bus.setWriteCallback(OAMADDR, [&](Byte b) {m_ppu.setOAMAddress(b);}) ||
-            !m_bus.setWriteCallback(PPUADDR, [&](Byte b) {m_ppu.setDataAddress(b);}) ||
-            !m_bus.setWriteCallback(PPUSCROL, [&](Byte b) {m_ppu.setScroll(b);}) ||
-            !m_bus.setWriteCallback(PPUDATA, [&](Byte b) {m_ppu.setData(b);}) ||
-            !m_bus.setWriteCallback(OAMDMA, [&](Byte b) {DMA(b);}) ||
-            !m_bus.setWriteCallback(JOY1, [&](Byte b) {m_controller1.strobe(b); m_controller2.strobe(b);}) ||
-            !m_bus.setWriteCallback(OAMDATA, [&](Byte b) {m_ppu.setOAMData(b);}))
+        if(!m_bus.connectIO(&m_ppu, &m_controller1, &m_controller2, [&](Byte b) {DMA(b);}))
         {
             LOG(Error) << "Critical error: Failed to set I/O callbacks" << std::endl;
         }
@@ -42,9 +21,24 @@ namespace sn
 
     bool Emulator::init(const std::string& rom_path)
     {
-        if (!m_cartridge.loadFromFile(rom_path))
+        auto cartridge = CartridgeRegistry::load(rom_path);
+        if (!cartridge)
             return false;
 
+        m_cartridge = *cartridge;
+
+        return setupCartridge();
+    }
+
+    bool Emulator::init(const Cartridge& cartridge)
+    {
+        m_cartridge = cartridge;
+
+        return setupCartridge();
+    }
+
+    bool Emulator::setupCartridge()
+    {
         m_mapper = Mapper::createMapper(static_cast<Mapper::Type>(m_cartridge.getMapper()),
                                         m_cartridge,
                                         [&](){ m_pictureBus.updateMirroring(); });
@@ -61,173 +55,190 @@ namespace sn
         m_cpu.reset();
         m_ppu.reset();
 
-        m_emulatorScreen.create(NESVideoWidth, NESVideoHeight, m_screenScale, sf::Color::Magenta);
-
         m_vblankCounter = 0;
         m_vblankFlag = false;
 
         return true;
     }
 
-    void Emulator::stepFrame()
+    //Increase when the layout of a state changes
+    static const Byte SaveStateVersion = 3;
+
+    SaveState Emulator::saveState() const
     {
-        m_vblankFlag = false;
+        SaveState state;
 
-        while(!m_vblankFlag)
-        {
-            //PPU
-            m_ppu.step();
-            m_ppu.step();
-            m_ppu.step();
-            //CPU
-            m_cpu.step();
-        }
+        if (!m_mapper)
+            return state;
 
-        m_vblankFlag = false;
+        StateWriter writer(state);
+
+        writer.write(SaveStateVersion);
+        writer.write(m_cartridge.getMapper());
+        writer.write<std::uint64_t>(m_cartridge.getHash());
+
+        saveMachineState(writer);
+        m_frameBuffer->saveState(writer);
+
+        return state;
     }
 
-    void Emulator::stepNFrames( uint64_t n )
+    void Emulator::saveMachineState(StateWriter& writer) const
     {
-        uint64_t endFrame = m_vblankCounter + n;
+        writer.write(m_vblankCounter);
+        writer.write(m_vblankFlag);
+
+        m_cpu.saveState(writer);
+        m_ppu.saveState(writer);
+        m_bus.saveState(writer);
+        m_pictureBus.saveState(writer);
+        m_mapper->saveState(writer);
+        m_controller1.saveState(writer);
+        m_controller2.saveState(writer);
+    }
 
-        while( m_vblankCounter < endFrame )
+    bool Emulator::loadState(const SaveState& state)
+    {
+        if (!m_mapper)
+            return false;
+
+        StateReader reader(state);
+
+        Byte version = 0, mapper = 0;
+        std::uint64_t romHash = 0;
+
+        reader.read(version);
+        reader.read(mapper);
+        reader.read(romHash);
+
+        if (!reader.good() || version != SaveStateVersion ||
+            mapper != m_cartridge.getMapper() || romHash != m_cartridge.getHash())
         {
-            stepFrame();
+            LOG(Error) << "Save state does not match the loaded cartridge" << std::endl;
+            return false;
         }
-    }
 
-    void Emulator::run(const std::string& rom_path)
-    {
-        if(!init(rom_path))
+        if (!loadMachineState(reader) ||
+            !m_frameBuffer->loadState(reader) ||
+            !reader.atEnd())
         {
-            LOG(Error) << "Emulator Init failed for ROM file: \"" << rom_path << "\"" << std::endl;
+            LOG(Error) << "Save state is corrupt, emulator state is undefined" << std::endl;
+            return false;
         }
 
-        sf::RenderWindow m_window;
+        return true;
+    }
+
+    bool Emulator::loadMachineState(StateReader& reader)
+    {
+        reader.read(m_vblankCounter);
+        reader.read(m_vblankFlag);
+
+        return m_cpu.loadState(reader) &&
+               m_ppu.loadState(reader) &&
+               m_bus.loadState(reader) &&
+               m_pictureBus.loadState(reader) &&
+               m_mapper->loadState(reader) &&
+               m_controller1.loadState(reader) &&
+               m_controller2.loadState(reader);
+    }
+
+    std::unique_ptr<Emulator> Emulator::fork(bool copyScreen) const
+    {
+        std::unique_ptr<Emulator> emulator(new Emulator());
+
+        if (!forkInto(*emulator, copyScreen))
+            return nullptr;
+
+        return emulator;
+    }
 
-        m_window.create(sf::VideoMode(NESVideoWidth * m_screenScale, NESVideoHeight * m_screenScale),
-                        "SimpleNES", sf::Style::Titlebar | sf::Style::Close);
-        m_window.setVerticalSyncEnabled(true);
+    bool Emulator::forkInto(Emulator& target, bool copyScreen) const
+    {
+        if (!m_mapper || &target == this)
+            return false;
 
-        std::chrono::high_resolution_clock::time_point m_cycleTimer;
-        std::chrono::high_resolution_clock::duration m_elapsedTime;
+        //Copies of a cartridge share its ROM, so this only builds a new mapper
+        if (!target.m_mapper || target.m_cartridge.getHash() != m_cartridge.getHash() ||
+            target.m_cartridge.getMapper() != m_cartridge.getMapper())
+        {
+            if (!target.init(m_cartridge))
+                return false;
+        }
 
-        m_cycleTimer = std::chrono::high_resolution_clock::now();
-        m_elapsedTime = m_cycleTimer - m_cycleTimer;
+        //The buffer keeps its capacity, so after the first fork this is two copies of the machine state
+        target.m_forkBuffer.data.clear();
+        StateWriter writer(target.m_forkBuffer);
+        saveMachineState(writer);
 
-        sf::Event event;
-        bool focus = true, pause = false;
-        while (m_window.isOpen())
+        StateReader reader(target.m_forkBuffer);
+        if (!target.loadMachineState(reader) || !reader.atEnd())
         {
-            while (m_window.pollEvent(event))
-            {
-                if (event.type == sf::Event::Closed ||
-                (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape))
-                {
-                    m_window.close();
-                    return;
-                }
-                else if (event.type == sf::Event::GainedFocus)
-                {
-                    focus = true;
-                    m_cycleTimer = std::chrono::high_resolution_clock::now();
-                }
-                else if (event.type == sf::Event::LostFocus)
-                    focus = false;
-                else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F2)
-                {
-                    pause = !pause;
-                    if (!pause)
-                        m_cycleTimer = std::chrono::high_resolution_clock::now();
-                }
-                else if (pause && event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::F3)
-                {
-                    for (int i = 0; i < 29781; ++i) //Around one frame
-                    {
-                        //PPU
-                        m_ppu.step();
-                        m_ppu.step();
-                        m_ppu.step();
-                        //CPU
-                        m_cpu.step();
-                    }
-                }
-                else if (focus && event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::F4)
-                {
-                    Log::get().setLevel(Info);
-                }
-                else if (focus && event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::F5)
-                {
-                    Log::get().setLevel(InfoVerbose);
-                }
-                else if (focus && event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::F6)
-                {
-                    Log::get().setLevel(CpuTrace);
-                }
-            }
-
-            if (focus && !pause)
-            {
-                m_elapsedTime += std::chrono::high_resolution_clock::now() - m_cycleTimer;
-                m_cycleTimer = std::chrono::high_resolution_clock::now();
-
-                while (m_elapsedTime > m_cpuCycleDuration)
-                {
-                    //PPU
-                    m_ppu.step();
-                    m_ppu.step();
-                    m_ppu.step();
-                    //CPU
-                    m_cpu.step();
-
-                    m_vblankFlag = false;
-
-                    m_elapsedTime -= m_cpuCycleDuration;
-                }
-
-                m_window.draw(m_emulatorScreen);
-                m_window.display();
-            }
-            else
-            {
-                sf::sleep(sf::milliseconds(1000/60));
-                //std::this_thread::sleep_for(std::chrono::milliseconds(1000/60)); //1/60 second
-            }
+            LOG(Error) << "Fork failed, emulator state is undefined" << std::endl;
+            return false;
         }
+
+        target.m_ppu.setRenderMode(m_ppu.getRenderMode());
+        target.m_frameBuffer->copyFrame(*m_frameBuffer, copyScreen);
+
+        return true;
     }
 
-    void Emulator::DMA(Byte page)
+    void Emulator::step()
     {
-        m_cpu.skipDMACycles();
-        auto page_ptr = m_bus.getPagePtr(page);
-        m_ppu.doDMA(page_ptr);
+        m_ppu.catchUp();
+        //PPU
+        m_ppu.step();
+        m_ppu.step();
+        m_ppu.step();
+        //CPU
+        m_cpu.step();
     }
 
-    void Emulator::setVideoHeight(int height)
+    void Emulator::resetCPU(Address start_addr)
+    {
+        m_cpu.reset(start_addr);
+    }
+
+    void Emulator::stepFrame()
     {
-        m_screenScale = height / float(NESVideoHeight);
-        LOG(Info) << "Scale: " << m_screenScale << " set. Screen: "
-                  << int(NESVideoWidth * m_screenScale) << "x" << int(NESVideoHeight * m_screenScale) << std::endl;
+        m_vblankFlag = false;
+
+        while(!m_vblankFlag)
+        {
+            //Run the CPU a whole instruction at a time ahead of the PPU, which catches up when the CPU
+            //accesses it. Near the start of vertical blank, where the NMI can fire, go cycle by cycle
+            if (m_ppu.deferSteps(3 * (m_cpu.getCyclesToNextInstruction() + 1)))
+                m_cpu.executeNext();
+            else
+                step();
+        }
+
+        m_ppu.catchUp();
+
+        m_vblankFlag = false;
     }
 
-    void Emulator::setVideoWidth(int width)
+    void Emulator::stepNFrames( uint64_t n )
     {
-        m_screenScale = width / float(NESVideoWidth);
-        LOG(Info) << "Scale: " << m_screenScale << " set. Screen: "
-                  << int(NESVideoWidth * m_screenScale) << "x" << int(NESVideoHeight * m_screenScale) << std::endl;
+        uint64_t endFrame = m_vblankCounter + n;
+
+        while( m_vblankCounter < endFrame )
+        {
+            stepFrame();
+        }
     }
 
-    void Emulator::setVideoScale(float scale)
+    void Emulator::DMA(Byte page)
     {
-        m_screenScale = scale;
-        LOG(Info) << "Scale: " << m_screenScale << " set. Screen: "
-                  << int(NESVideoWidth * m_screenScale) << "x" << int(NESVideoHeight * m_screenScale) << std::endl;
+        m_cpu.skipDMACycles();
+        auto page_ptr = m_bus.getPagePtr(page);
+        m_ppu.doDMA(page_ptr);
     }
 
-    void Emulator::setKeys(const std::vector<sf::Keyboard::Key>& p1, const std::vector<sf::Keyboard::Key>& p2)
+    void Emulator::setRenderMode(RenderMode mode)
     {
-        m_controller1.setKeyBindings(p1);
-        m_controller2.setKeyBindings(p2);
+        m_ppu.setRenderMode(mode);
     }
 
     void Emulator::setControllerCallbacks(const std::vector<std::function<bool(void)>>& p1, const std::vector<std::function<bool(void)>>& p2)
@@ -242,15 +253,23 @@ namespace sn
         m_controller2.setCallbackMap(p2);
     }
 
+    void Emulator::setControllerState(size_t port, Byte buttons)
+    {
+        if (port == 0)
+            m_controller1.setButtonStates(buttons);
+        else
+            m_controller2.setButtonStates(buttons);
+    }
+
     Byte Emulator::peakMemory(Address addr) const
     {
         //return m_bus.read( addr );
         return m_bus.peak( addr );
     }
 
-    std::shared_ptr<sf::Image> Emulator::getScreenData() const
+    std::shared_ptr<const FrameBuffer> Emulator::getScreenData() const
     {
-        return m_emulatorScreen.getScreenData();
+        return m_frameBuffer;
     }
 
     uint64_t Emulator::getNumVBlank() const
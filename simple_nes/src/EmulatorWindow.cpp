@@ -0,0 +1,142 @@
+#include "EmulatorWindow.h"
+#include "Log.h"
+
+namespace sn
+{
+    EmulatorWindow::EmulatorWindow() :
+        m_screenScale(2.f),
+        m_cpuCycleDuration(std::chrono::nanoseconds(559))
+    {}
+
+    void EmulatorWindow::run(const std::string& rom_path)
+    {
+        if(!m_emulator.init(rom_path))
+        {
+            LOG(Error) << "Emulator Init failed for ROM file: \"" << rom_path << "\"" << std::endl;
+        }
+
+        m_emulatorScreen.create(NESVideoWidth, NESVideoHeight, m_screenScale);
+        m_emulatorScreen.setScreenData(m_emulator.getScreenData());
+
+        sf::RenderWindow m_window;
+
+        m_window.create(sf::VideoMode(NESVideoWidth * m_screenScale, NESVideoHeight * m_screenScale),
+                        "SimpleNES", sf::Style::Titlebar | sf::Style::Close);
+        m_window.setVerticalSyncEnabled(true);
+
+        std::chrono::high_resolution_clock::time_point m_cycleTimer;
+        std::chrono::high_resolution_clock::duration m_elapsedTime;
+
+        m_cycleTimer = std::chrono::high_resolution_clock::now();
+        m_elapsedTime = m_cycleTimer - m_cycleTimer;
+
+        sf::Event event;
+        bool focus = true, pause = false;
+        while (m_window.isOpen())
+        {
+            while (m_window.pollEvent(event))
+            {
+                if (event.type == sf::Event::Closed ||
+                (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape))
+                {
+                    m_window.close();
+                    return;
+                }
+                else if (event.type == sf::Event::GainedFocus)
+                {
+                    focus = true;
+                    m_cycleTimer = std::chrono::high_resolution_clock::now();
+                }
+                else if (event.type == sf::Event::LostFocus)
+                    focus = false;
+                else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F2)
+                {
+                    pause = !pause;
+                    if (!pause)
+                        m_cycleTimer = std::chrono::high_resolution_clock::now();
+                }
+                else if (pause && event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::F3)
+                {
+                    for (int i = 0; i < 29781; ++i) //Around one frame
+                    {
+                        m_emulator.step();
+                    }
+                }
+                else if (focus && event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::F4)
+                {
+                    Log::get().setLevel(Info);
+                }
+                else if (focus && event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::F5)
+                {
+                    Log::get().setLevel(InfoVerbose);
+                }
+                else if (focus && event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::F6)
+                {
+                    Log::get().setLevel(CpuTrace);
+                }
+            }
+
+            if (focus && !pause)
+            {
+                m_elapsedTime += std::chrono::high_resolution_clock::now() - m_cycleTimer;
+                m_cycleTimer = std::chrono::high_resolution_clock::now();
+
+                while (m_elapsedTime > m_cpuCycleDuration)
+                {
+                    m_emulator.step();
+
+                    m_elapsedTime -= m_cpuCycleDuration;
+                }
+
+                m_window.draw(m_emulatorScreen);
+                m_window.display();
+            }
+            else
+            {
+                sf::sleep(sf::milliseconds(1000/60));
+                //std::this_thread::sleep_for(std::chrono::milliseconds(1000/60)); //1/60 second
+            }
+        }
+    }
+
+    void EmulatorWindow::setVideoHeight(int height)
+    {
+        m_screenScale = height / float(NESVideoHeight);
+        LOG(Info) << "Scale: " << m_screenScale << " set. Screen: "
+                  << int(NESVideoWidth * m_screenScale) << "x" << int(NESVideoHeight * m_screenScale) << std::endl;
+    }
+
+    void EmulatorWindow::setVideoWidth(int width)
+    {
+        m_screenScale = width / float(NESVideoWidth);
+        LOG(Info) << "Scale: " << m_screenScale << " set. Screen: "
+                  << int(NESVideoWidth * m_screenScale) << "x" << int(NESVideoHeight * m_screenScale) << std::endl;
+    }
+
+    void EmulatorWindow::setVideoScale(float scale)
+    {
+        m_screenScale = scale;
+        LOG(Info) << "Scale: " << m_screenScale << " set. Screen: "
+                  << int(NESVideoWidth * m_screenScale) << "x" << int(NESVideoHeight * m_screenScale) << std::endl;
+    }
+
+    void EmulatorWindow::setKeys(const std::vector<sf::Keyboard::Key>& p1, const std::vector<sf::Keyboard::Key>& p2)
+    {
+        auto keyCallbacks = [](const std::vector<sf::Keyboard::Key>& keys)
+        {
+            std::vector<std::function<bool(void)>> callbacks;
+
+            for (auto key : keys)
+                callbacks.emplace_back([=](void) -> bool { return sf::Keyboard::isKeyPressed(key); });
+
+            return callbacks;
+        };
+
+        m_emulator.setControllerCallbacks(keyCallbacks(p1), keyCallbacks(p2));
+    }
+
+    Emulator& EmulatorWindow::getEmulator()
+    {
+        return m_emulator;
+    }
+}
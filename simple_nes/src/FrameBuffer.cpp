@@ -0,0 +1,75 @@
+#include <algorithm>
+
+#include "FrameBuffer.h"
+#include "PaletteColors.h"
+
+namespace sn
+{
+    namespace
+    {
+        struct PaletteRGBA
+        {
+            Byte rgba[64][4];
+
+            PaletteRGBA()
+            {
+                for (std::size_t i = 0; i < 64; ++i)
+                {
+                    rgba[i][0] = colors[i] >> 24;
+                    rgba[i][1] = colors[i] >> 16;
+                    rgba[i][2] = colors[i] >> 8;
+                    rgba[i][3] = colors[i];
+                }
+            }
+        };
+
+        const PaletteRGBA paletteRGBA;
+    }
+
+    const std::size_t FrameBuffer::Width;
+    const std::size_t FrameBuffer::Height;
+
+    FrameBuffer::FrameBuffer(Byte fillIndex) :
+        m_front(0)
+    {
+        std::fill(&m_frames[0][0][0], &m_frames[0][0][0] + sizeof(m_frames), fillIndex & 0x3f);
+    }
+
+    void FrameBuffer::copyFrame(const FrameBuffer& other, bool copyPixels)
+    {
+        m_front = other.m_front;
+        if (copyPixels)
+            std::copy(other.getFrame(), other.getFrame() + Width * Height, &m_frames[m_front][0][0]);
+    }
+
+    void FrameBuffer::copyRGBA(Byte* destination) const
+    {
+        const Byte* frame = getFrame();
+
+        for (std::size_t i = 0; i < Width * Height; ++i, destination += 4)
+            std::copy(paletteRGBA.rgba[frame[i]], paletteRGBA.rgba[frame[i]] + 4, destination);
+    }
+
+    const Byte* FrameBuffer::getPaletteRGBA(Byte paletteIndex)
+    {
+        return paletteRGBA.rgba[paletteIndex & 0x3f];
+    }
+
+    void FrameBuffer::saveState(StateWriter& writer) const
+    {
+        writer.write(m_front);
+        writer.writeBytes(&m_frames[0][0][0], sizeof(m_frames));
+    }
+
+    bool FrameBuffer::loadState(StateReader& reader)
+    {
+        int front = 0;
+
+        if (!reader.read(front) || (front != 0 && front != 1) ||
+            !reader.readBytes(&m_frames[0][0][0], sizeof(m_frames)))
+            return false;
+
+        m_front = front;
+        return true;
+    }
+}
@@ -2,6 +2,13 @@
 
 namespace sn
 {
+    Log::Log() :
+        m_logLevel(None),
+        m_logStream(&std::cout),
+        m_cpuTrace(&std::cout)
+    {
+    }
+
     Log::~Log()
     {
     }
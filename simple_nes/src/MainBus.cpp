@@ -1,12 +1,17 @@
 #include "MainBus.h"
 #include <cstring>
+#include "PPU.h"
+#include "Controller.h"
 #include "Log.h"
 
 namespace sn
 {
     MainBus::MainBus() :
         m_RAM(0x800, 0),
-        m_mapper(nullptr)
+        m_mapper(nullptr),
+        m_ppu(nullptr),
+        m_controller1(nullptr),
+        m_controller2(nullptr)
     {
     }
 
@@ -18,23 +23,25 @@ namespace sn
         {
             if (addr < 0x4000) //PPU registers, mirrored
             {
-                auto it = m_readCallbacks.find(static_cast<IORegisters>(addr & 0x2007));
-                if (it != m_readCallbacks.end())
-                    return (it -> second)();
-                    //Second object is the pointer to the function object
-                    //Dereference the function pointer and call it
-                else
-                    LOG(InfoVerbose) << "No read callback registered for I/O register at: " << std::hex << +addr << std::endl;
+                m_ppu->catchUp();
+                switch (addr & 0x2007)
+                {
+                    case PPUSTATUS: return m_ppu->getStatus();
+                    case OAMDATA:   return m_ppu->getOAMData();
+                    case PPUDATA:   return m_ppu->getData();
+                    default:
+                        LOG(InfoVerbose) << "No read callback registered for I/O register at: " << std::hex << +addr << std::endl;
+                }
             }
             else if (addr < 0x4018 && addr >= 0x4014) //Only *some* IO registers
             {
-                auto it = m_readCallbacks.find(static_cast<IORegisters>(addr));
-                if (it != m_readCallbacks.end())
-                    return (it -> second)();
-                    //Second object is the pointer to the function object
-                    //Dereference the function pointer and call it
-                else
-                    LOG(InfoVerbose) << "No read callback registered for I/O register at: " << std::hex << +addr << std::endl;
+                switch (addr)
+                {
+                    case JOY1:  return m_controller1->read();
+                    case JOY2:  return m_controller2->read();
+                    default:
+                        LOG(InfoVerbose) << "No read callback registered for I/O register at: " << std::hex << +addr << std::endl;
+                }
             }
             else
                 LOG(InfoVerbose) << "Read access attempt at: " << std::hex << +addr << std::endl;
@@ -102,23 +109,31 @@ namespace sn
         {
             if (addr < 0x4000) //PPU registers, mirrored
             {
-                auto it = m_writeCallbacks.find(static_cast<IORegisters>(addr & 0x2007));
-                if (it != m_writeCallbacks.end())
-                    (it -> second)(value);
-                    //Second object is the pointer to the function object
-                    //Dereference the function pointer and call it
-                else
-                    LOG(InfoVerbose) << "No write callback registered for I/O register at: " << std::hex << +addr << std::endl;
+                m_ppu->catchUp();
+                switch (addr & 0x2007)
+                {
+                    case PPUCTRL:   m_ppu->control(value);          break;
+                    case PPUMASK:   m_ppu->setMask(value);          break;
+                    case OAMADDR:   m_ppu->setOAMAddress(value);    break;
+                    case OAMDATA:   m_ppu->setOAMData(value);       break;
+                    case PPUSCROL:  m_ppu->setScroll(value);        break;
+                    case PPUADDR:   m_ppu->setDataAddress(value);   break;
+                    case PPUDATA:   m_ppu->setData(value);          break;
+                    default:
+                        LOG(InfoVerbose) << "No write callback registered for I/O register at: " << std::hex << +addr << std::endl;
+                }
             }
             else if (addr < 0x4017 && addr >= 0x4014) //only some registers
             {
-                auto it = m_writeCallbacks.find(static_cast<IORegisters>(addr));
-                if (it != m_writeCallbacks.end())
-                    (it -> second)(value);
-                    //Second object is the pointer to the function object
-                    //Dereference the function pointer and call it
-                else
-                    LOG(InfoVerbose) << "No write callback registered for I/O register at: " << std::hex << +addr << std::endl;
+                switch (addr)
+                {
+                    case OAMDMA:    m_ppu->catchUp();
+                                    m_dmaCallback(value);           break;
+                    case JOY1:      m_controller1->strobe(value);
+                                    m_controller2->strobe(value);   break;
+                    default:
+                        LOG(InfoVerbose) << "No write callback registered for I/O register at: " << std::hex << +addr << std::endl;
+                }
             }
             else
                 LOG(InfoVerbose) << "Write access attmept at: " << std::hex << +addr << std::endl;
@@ -136,6 +151,8 @@ namespace sn
         }
         else
         {
+            //Bank switches change what the PPU fetches
+            m_ppu->catchUp();
             m_mapper->writePRG(addr, value);
         }
     }
@@ -162,6 +179,7 @@ namespace sn
         }
         else
         {
+            return m_mapper->getPagePtr(addr);
         }
         return nullptr;
     }
@@ -182,24 +200,31 @@ namespace sn
         return true;
     }
 
-    bool MainBus::setWriteCallback(IORegisters reg, std::function<void(Byte)> callback)
+    bool MainBus::connectIO(PPU* ppu, Controller* controller1, Controller* controller2, std::function<void(Byte)> dma)
     {
-        if (!callback)
+        if (!ppu || !controller1 || !controller2 || !dma)
         {
-            LOG(Error) << "callback argument is nullptr" << std::endl;
+            LOG(Error) << "I/O device argument is nullptr" << std::endl;
             return false;
         }
-        return m_writeCallbacks.emplace(reg, callback).second;
+
+        m_ppu = ppu;
+        m_controller1 = controller1;
+        m_controller2 = controller2;
+        m_dmaCallback = dma;
+        return true;
     }
 
-    bool MainBus::setReadCallback(IORegisters reg, std::function<Byte(void)> callback)
+    void MainBus::saveState(StateWriter& writer) const
     {
-        if (!callback)
-        {
-            LOG(Error) << "callback argument is nullptr" << std::endl;
-            return false;
-        }
-        return m_readCallbacks.emplace(reg, callback).second;
+        writer.write(m_RAM);
+        writer.write(m_extRAM);
     }
 
+    bool MainBus::loadState(StateReader& reader)
+    {
+        reader.read(m_RAM);
+        reader.read(m_extRAM);
+        return reader.good();
+    }
 }
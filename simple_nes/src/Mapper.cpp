@@ -10,8 +10,20 @@ namespace sn
     {
         return static_cast<NameTableMirroring>(m_cartridge.getNameTableMirroring());
     }
+
+    void Mapper::mapPRG(Address addr, std::size_t size, const Byte* memory)
+    {
+        for (std::size_t offset = 0; offset < size; offset += 0x2000)
+            m_pagesPRG[((addr + offset) >> 13) & 0x3] = memory + offset;
+    }
+
+    void Mapper::mapCHR(Address addr, std::size_t size, const Byte* memory)
+    {
+        for (std::size_t offset = 0; offset < size; offset += 0x400)
+            m_pagesCHR[((addr + offset) >> 10) & 0x7] = memory + offset;
+    }
    
-    std::unique_ptr<Mapper> Mapper::createMapper(Mapper::Type mapper_t, sn::Cartridge& cart, std::function<void(void)> mirroring_cb)
+    std::unique_ptr<Mapper> Mapper::createMapper(Mapper::Type mapper_t, const sn::Cartridge& cart, std::function<void(void)> mirroring_cb)
     {
         std::unique_ptr<Mapper> ret(nullptr);
         switch (mapper_t)
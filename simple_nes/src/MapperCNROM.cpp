@@ -3,7 +3,7 @@
 
 namespace sn
 {
-    MapperCNROM::MapperCNROM(Cartridge &cart) :
+    MapperCNROM::MapperCNROM(const Cartridge &cart) :
         Mapper(cart, Mapper::CNROM),
         m_selectCHR(0)
     {
@@ -15,36 +15,46 @@ namespace sn
         {
             m_oneBank = false;
         }
-    }
 
-    Byte MapperCNROM::readPRG(Address addr)
-    {
         if (!m_oneBank)
-            return m_cartridge.getROM()[addr - 0x8000];
+            mapPRG(0x8000, 0x8000, &cart.getROM()[0]);
         else //mirrored
-            return m_cartridge.getROM()[(addr - 0x8000) & 0x3fff];
+        {
+            mapPRG(0x8000, 0x4000, &cart.getROM()[0]);
+            mapPRG(0xc000, 0x4000, &cart.getROM()[0]);
+        }
+
+        updateCHRBank();
+    }
+
+    void MapperCNROM::updateCHRBank()
+    {
+        //Wraps banks past the end of smaller CHR ROMs
+        mapCHR(0, 0x2000, &m_cartridge.getVROM()[(m_selectCHR << 13) % m_cartridge.getVROM().size()]);
     }
 
     void MapperCNROM::writePRG(Address addr, Byte value)
     {
         m_selectCHR = value & 0x3;
+        updateCHRBank();
     }
 
-    const Byte* MapperCNROM::getPagePtr(Address addr)
+    void MapperCNROM::writeCHR(Address addr, Byte value)
     {
-        if (!m_oneBank)
-            return &m_cartridge.getROM()[addr - 0x8000];
-        else //mirrored
-            return &m_cartridge.getROM()[(addr - 0x8000) & 0x3fff];
+        LOG(Info) << "Read-only CHR memory write attempt at " << std::hex << addr << std::endl;
     }
 
-    Byte MapperCNROM::readCHR(Address addr)
+    void MapperCNROM::saveState(StateWriter& writer) const
     {
-        return m_cartridge.getVROM()[addr | (m_selectCHR << 13)];
+        writer.write(m_selectCHR);
     }
 
-    void MapperCNROM::writeCHR(Address addr, Byte value)
+    bool MapperCNROM::loadState(StateReader& reader)
     {
-        LOG(Info) << "Read-only CHR memory write attempt at " << std::hex << addr << std::endl;
+        if (!reader.read(m_selectCHR))
+            return false;
+
+        updateCHRBank();
+        return true;
     }
-}
\ No newline at end of file
+}
@@ -3,7 +3,7 @@
 
 namespace sn
 {
-    MapperNROM::MapperNROM(Cartridge &cart) :
+    MapperNROM::MapperNROM(const Cartridge &cart) :
         Mapper(cart, Mapper::NROM)
     {
         if (cart.getROM().size() == 0x4000) //1 bank
@@ -23,14 +23,16 @@ namespace sn
         }
         else
             m_usesCharacterRAM = false;
-    }
 
-    Byte MapperNROM::readPRG(Address addr)
-    {
         if (!m_oneBank)
-            return m_cartridge.getROM()[addr - 0x8000];
+            mapPRG(0x8000, 0x8000, &cart.getROM()[0]);
         else //mirrored
-            return m_cartridge.getROM()[(addr - 0x8000) & 0x3fff];
+        {
+            mapPRG(0x8000, 0x4000, &cart.getROM()[0]);
+            mapPRG(0xc000, 0x4000, &cart.getROM()[0]);
+        }
+
+        mapCHR(0, 0x2000, m_usesCharacterRAM ? m_characterRAM.data() : &cart.getVROM()[0]);
     }
 
     void MapperNROM::writePRG(Address addr, Byte value)
@@ -38,27 +40,21 @@ namespace sn
         LOG(InfoVerbose) << "ROM memory write attempt at " << +addr << " to set " << +value << std::endl;
     }
 
-    const Byte* MapperNROM::getPagePtr(Address addr)
+    void MapperNROM::writeCHR(Address addr, Byte value)
     {
-        if (!m_oneBank)
-            return &m_cartridge.getROM()[addr - 0x8000];
-        else //mirrored
-            return &m_cartridge.getROM()[(addr - 0x8000) & 0x3fff];
+        if (m_usesCharacterRAM)
+            m_characterRAM[addr] = value;
+        else
+            LOG(Info) << "Read-only CHR memory write attempt at " << std::hex << addr << std::endl;
     }
 
-    Byte MapperNROM::readCHR(Address addr)
+    void MapperNROM::saveState(StateWriter& writer) const
     {
-        if (m_usesCharacterRAM)
-            return m_characterRAM[addr];
-        else
-            return m_cartridge.getVROM()[addr];
+        writer.write(m_characterRAM);
     }
 
-    void MapperNROM::writeCHR(Address addr, Byte value)
+    bool MapperNROM::loadState(StateReader& reader)
     {
-        if (m_usesCharacterRAM)
-            m_characterRAM[addr] = value;
-        else
-            LOG(Info) << "Read-only CHR memory write attempt at " << std::hex << addr << std::endl;
+        return reader.read(m_characterRAM);
     }
-}
\ No newline at end of file
+}
@@ -3,7 +3,7 @@
 
 namespace sn
 {
-    MapperSxROM::MapperSxROM(Cartridge &cart, std::function<void(void)> mirroring_cb) :
+    MapperSxROM::MapperSxROM(const Cartridge &cart, std::function<void(void)> mirroring_cb) :
         Mapper(cart, Mapper::SxROM),
         m_mirroringCallback(mirroring_cb),
         m_mirroing(Horizontal),
@@ -35,14 +35,22 @@ namespace sn
 
         m_firstBankPRG = &cart.getROM()[0]; //first bank
         m_secondBankPRG = &cart.getROM()[cart.getROM().size() - 0x4000/*0x2000 * 0x0e*/]; //last bank
+
+        updatePageTables();
     }
 
-    Byte MapperSxROM::readPRG(Address addr)
+    void MapperSxROM::updatePageTables()
     {
-        if (addr < 0xc000)
-            return *(m_firstBankPRG + (addr & 0x3fff));
+        mapPRG(0x8000, 0x4000, m_firstBankPRG);
+        mapPRG(0xc000, 0x4000, m_secondBankPRG);
+
+        if (m_usesCharacterRAM)
+            mapCHR(0, 0x2000, m_characterRAM.data());
         else
-            return *(m_secondBankPRG + (addr & 0x3fff));
+        {
+            mapCHR(0, 0x1000, m_firstBankCHR);
+            mapCHR(0x1000, 0x1000, m_secondBankCHR);
+        }
     }
 
     NameTableMirroring MapperSxROM::getNameTableMirroring()
@@ -114,6 +122,8 @@ namespace sn
 
                 m_tempRegister = 0;
                 m_writeCounter = 0;
+
+                updatePageTables();
             }
         }
         else //reset
@@ -122,6 +132,8 @@ namespace sn
             m_writeCounter = 0;
             m_modePRG = 3;
             calculatePRGPointers();
+
+            updatePageTables();
         }
     }
 
@@ -145,29 +157,92 @@ namespace sn
         }
     }
 
-    const Byte* MapperSxROM::getPagePtr(Address addr)
+    void MapperSxROM::writeCHR(Address addr, Byte value)
     {
-        if (addr < 0xc000)
-            return (m_firstBankPRG + (addr & 0x3fff));
+        if (m_usesCharacterRAM)
+            m_characterRAM[addr] = value;
         else
-            return (m_secondBankPRG + (addr & 0x3fff));
+            LOG(Info) << "Read-only CHR memory write attempt at " << std::hex << addr << std::endl;
     }
 
-    Byte MapperSxROM::readCHR(Address addr)
+    //The bank pointers are stored as offsets into the cartridge, -1 for none
+    namespace
     {
-        if (m_usesCharacterRAM)
-            return m_characterRAM[addr];
-        else if (addr < 0x1000)
-            return *(m_firstBankCHR + addr);
-        else
-            return *(m_secondBankCHR + (addr & 0xfff));
+        std::int64_t bankOffset(const Byte* bank, const std::vector<Byte>& memory)
+        {
+            return bank ? bank - memory.data() : -1;
+        }
+
+        //The whole bank has to fit, the page tables map bankSize bytes from the pointer
+        bool bankPointer(std::int64_t offset, std::size_t bankSize, const std::vector<Byte>& memory, const Byte*& bank)
+        {
+            if (offset < 0)
+            {
+                bank = nullptr;
+                return true;
+            }
+
+            if (memory.size() < bankSize || std::uint64_t(offset) > memory.size() - bankSize)
+                return false;
+
+            bank = memory.data() + offset;
+            return true;
+        }
     }
 
-    void MapperSxROM::writeCHR(Address addr, Byte value)
+    void MapperSxROM::saveState(StateWriter& writer) const
     {
-        if (m_usesCharacterRAM)
-            m_characterRAM[addr] = value;
-        else
-            LOG(Info) << "Read-only CHR memory write attempt at " << std::hex << addr << std::endl;
+        writer.write(m_mirroing);
+
+        writer.write(m_modeCHR);
+        writer.write(m_modePRG);
+
+        writer.write(m_tempRegister);
+        writer.write(m_writeCounter);
+
+        writer.write(m_regPRG);
+        writer.write(m_regCHR0);
+        writer.write(m_regCHR1);
+
+        writer.write(bankOffset(m_firstBankPRG, m_cartridge.getROM()));
+        writer.write(bankOffset(m_secondBankPRG, m_cartridge.getROM()));
+
+        writer.write(bankOffset(m_firstBankCHR, m_cartridge.getVROM()));
+        writer.write(bankOffset(m_secondBankCHR, m_cartridge.getVROM()));
+
+        writer.write(m_characterRAM);
+    }
+
+    bool MapperSxROM::loadState(StateReader& reader)
+    {
+        reader.read(m_mirroing);
+
+        reader.read(m_modeCHR);
+        reader.read(m_modePRG);
+
+        reader.read(m_tempRegister);
+        reader.read(m_writeCounter);
+
+        reader.read(m_regPRG);
+        reader.read(m_regCHR0);
+        reader.read(m_regCHR1);
+
+        std::int64_t firstPRG = -1, secondPRG = -1, firstCHR = -1, secondCHR = -1;
+
+        reader.read(firstPRG);
+        reader.read(secondPRG);
+        reader.read(firstCHR);
+        reader.read(secondCHR);
+
+        if (!reader.good() ||
+            !bankPointer(firstPRG, 0x4000, m_cartridge.getROM(), m_firstBankPRG) ||
+            !bankPointer(secondPRG, 0x4000, m_cartridge.getROM(), m_secondBankPRG) ||
+            !bankPointer(firstCHR, 0x1000, m_cartridge.getVROM(), m_firstBankCHR) ||
+            !bankPointer(secondCHR, 0x1000, m_cartridge.getVROM(), m_secondBankCHR) ||
+            !reader.read(m_characterRAM))
+            return false;
+
+        updatePageTables();
+        return true;
     }
 }
@@ -3,7 +3,7 @@
 
 namespace sn
 {
-    MapperUxROM::MapperUxROM(Cartridge &cart) :
+    MapperUxROM::MapperUxROM(const Cartridge &cart) :
         Mapper(cart, Mapper::UxROM),
         m_selectPRG(0)
     {
@@ -17,42 +17,43 @@ namespace sn
             m_usesCharacterRAM = false;
 
         m_lastBankPtr = &cart.getROM()[cart.getROM().size() - 0x4000]; //last - 16KB
+
+        mapPRG(0xc000, 0x4000, m_lastBankPtr);
+        mapCHR(0, 0x2000, m_usesCharacterRAM ? m_characterRAM.data() : &cart.getVROM()[0]);
+        updatePRGBank();
     }
 
-    Byte MapperUxROM::readPRG(Address addr)
+    void MapperUxROM::updatePRGBank()
     {
-        if (addr < 0xc000)
-            return m_cartridge.getROM()[((addr - 0x8000) & 0x3fff) | (m_selectPRG << 14)];
-        else
-            return *(m_lastBankPtr + (addr & 0x3fff));
+        //Wraps banks past the end of the ROM
+        mapPRG(0x8000, 0x4000, &m_cartridge.getROM()[(m_selectPRG << 14) % m_cartridge.getROM().size()]);
     }
 
     void MapperUxROM::writePRG(Address addr, Byte value)
     {
         m_selectPRG = value;
+        updatePRGBank();
     }
 
-    const Byte* MapperUxROM::getPagePtr(Address addr)
+    void MapperUxROM::writeCHR(Address addr, Byte value)
     {
-        if (addr < 0xc000)
-            return &m_cartridge.getROM()[((addr - 0x8000) & 0x3fff) | (m_selectPRG << 14)];
+        if (m_usesCharacterRAM)
+            m_characterRAM[addr] = value;
         else
-            return m_lastBankPtr + (addr & 0x3fff);
+            LOG(Info) << "Read-only CHR memory write attempt at " << std::hex << addr << std::endl;
     }
 
-    Byte MapperUxROM::readCHR(Address addr)
+    void MapperUxROM::saveState(StateWriter& writer) const
     {
-        if (m_usesCharacterRAM)
-            return m_characterRAM[addr];
-        else
-            return m_cartridge.getVROM()[addr];
+        writer.write(m_selectPRG);
+        writer.write(m_characterRAM);
     }
 
-    void MapperUxROM::writeCHR(Address addr, Byte value)
+    bool MapperUxROM::loadState(StateReader& reader)
     {
-        if (m_usesCharacterRAM)
-            m_characterRAM[addr] = value;
-        else
-            LOG(Info) << "Read-only CHR memory write attempt at " << std::hex << addr << std::endl;
+        reader.read(m_selectPRG);
+        reader.read(m_characterRAM);
+        updatePRGBank();
+        return reader.good();
     }
-}
\ No newline at end of file
+}
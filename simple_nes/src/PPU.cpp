@@ -1,13 +1,14 @@
 #include "PPU.h"
 #include "Log.h"
+#include <algorithm>
 
 namespace sn
 {
-    PPU::PPU(PictureBus& bus, VirtualScreen& screen) :
+    PPU::PPU(PictureBus& bus, FrameBuffer& frameBuffer) :
         m_bus(bus),
-        m_screen(screen),
+        m_frameBuffer(frameBuffer),
         m_spriteMemory(64 * 4),
-        m_pictureBuffer(ScanlineVisibleDots, std::vector<sf::Color>(VisibleScanlines, sf::Color::Magenta))
+        m_renderMode(DrawPixels)
     {}
 
     void PPU::reset()
@@ -16,6 +17,7 @@ namespace sn
         m_showBackground = m_showSprites = m_evenFrame = m_firstWrite = true;
         m_bgPage = m_sprPage = Low;
         m_dataAddress = m_cycle = m_scanline = m_spriteDataAddress = m_fineXScroll = m_tempAddress = 0;
+        m_pendingSteps = 0;
         //m_baseNameTable = 0x2000;
         m_dataAddrIncrement = 1;
         m_pipelineState = PreRender;
@@ -28,6 +30,16 @@ namespace sn
         m_vblankCallback = cb;
     }
 
+    void PPU::setRenderMode(RenderMode mode)
+    {
+        m_renderMode = mode;
+    }
+
+    RenderMode PPU::getRenderMode() const
+    {
+        return m_renderMode;
+    }
+
     void PPU::step()
     {
         switch (m_pipelineState)
@@ -57,7 +69,21 @@ namespace sn
                 }
                 break;
             case Render:
-                if (m_cycle > 0 && m_cycle <= ScanlineVisibleDots)
+                if (m_cycle > 0 && m_cycle <= ScanlineVisibleDots && m_renderMode == SkipPixels && !canHitSpriteZero())
+                {
+                    //Only the scrolling is left without pixels
+                    if (m_showBackground && (m_fineXScroll + m_cycle - 1) % 8 == 7)
+                    {
+                        if ((m_dataAddress & 0x001F) == 31)
+                        {
+                            m_dataAddress &= ~0x001F;
+                            m_dataAddress ^= 0x0400;
+                        }
+                        else
+                            m_dataAddress += 1;
+                    }
+                }
+                else if (m_cycle > 0 && m_cycle <= ScanlineVisibleDots)
                 {
                     Byte bgColor = 0, sprColor = 0;
                     bool bgOpaque = false, sprOpaque = true;
@@ -177,8 +203,7 @@ namespace sn
                         paletteAddr = 0;
                     //else bgColor
 
-//                     m_screen.setPixel(x, y, sf::Color(colors[m_bus.readPalette(paletteAddr)]));
-                    m_pictureBuffer[x][y] = sf::Color(colors[m_bus.readPalette(paletteAddr)]);
+                    m_frameBuffer.setPixel(x, y, m_bus.readPalette(paletteAddr));
                 }
                 else if (m_cycle == ScanlineVisibleDots + 1 && m_showBackground)
                 {
@@ -254,13 +279,8 @@ namespace sn
                     m_cycle = 0;
                     m_pipelineState = VerticalBlank;
 
-                    for (size_t x = 0; x < m_pictureBuffer.size(); ++x)
-                    {
-                        for (size_t y = 0; y < m_pictureBuffer[0].size(); ++y)
-                        {
-                            m_screen.setPixel(x, y, m_pictureBuffer[x][y]);
-                        }
-                    }
+                    if (m_renderMode == DrawPixels)
+                        m_frameBuffer.swap();
 
                     //Should technically be done at first dot of VBlank, but this is close enough
 //                     m_vblank = true;
@@ -298,6 +318,211 @@ namespace sn
         ++m_cycle;
     }
 
+    bool PPU::deferSteps(int steps)
+    {
+        if (m_pendingSteps + steps > getStepsToVBlank())
+            return false;
+
+        m_pendingSteps += steps;
+        return true;
+    }
+
+    void PPU::catchUp()
+    {
+        int steps = m_pendingSteps;
+        m_pendingSteps = 0;
+
+        while (steps > 0)
+        {
+            //Nothing can write a register in the middle of a batch, so a batch spanning the visible part
+            //of a scanline can draw it in one go. Anything else goes a dot at a time
+            if (m_pipelineState == Render && m_cycle == 1 && steps >= ScanlineVisibleDots)
+            {
+                renderScanline();
+                m_cycle += ScanlineVisibleDots;
+                steps -= ScanlineVisibleDots;
+            }
+            else
+            {
+                //Up to where the next scanline could start, no later
+                int run = std::min(steps, std::max(1, ScanlineEndCycle - m_cycle));
+                steps -= run;
+                while (run--)
+                    step();
+            }
+        }
+    }
+
+    void PPU::renderScanline()
+    {
+        int y = m_scanline;
+
+        //Without pixels only the scrolling and a possible sprite-0 hit are left
+        if (m_renderMode == SkipPixels && !canHitSpriteZero())
+        {
+            //Coarse X goes up once per tile, 32 times, wrapping around once into the other nametable
+            if (m_showBackground)
+                m_dataAddress ^= 0x0400;
+            return;
+        }
+
+        //Sprite pixels of the line, the first opaque sprite in m_scanlineSprites takes the dot like in step()
+        std::array<Byte, ScanlineVisibleDots> sprColors;
+        std::array<bool, ScanlineVisibleDots> sprForeground;
+        std::array<bool, ScanlineVisibleDots> sprZero;
+        sprColors.fill(0);
+
+        if (m_showSprites)
+        {
+            for (auto i : m_scanlineSprites)
+            {
+                Byte spr_x     = m_spriteMemory[i * 4 + 3],
+                     spr_y     = m_spriteMemory[i * 4 + 0] + 1,
+                     tile      = m_spriteMemory[i * 4 + 1],
+                     attribute = m_spriteMemory[i * 4 + 2];
+
+                int length = (m_longSprites) ? 16 : 8;
+
+                int y_offset = (y - spr_y) % length;
+
+                if ((attribute & 0x80) != 0) //IF flipping vertically
+                    y_offset ^= (length - 1);
+
+                Address addr = 0;
+
+                if (!m_longSprites)
+                {
+                    addr = tile * 16 + y_offset;
+                    if (m_sprPage == High) addr += 0x1000;
+                }
+                else //8x16 sprites
+                {
+                    y_offset = (y_offset & 7) | ((y_offset & 8) << 1);
+                    addr = (tile >> 1) * 32 + y_offset;
+                    addr |= (tile & 1) << 12;
+                }
+
+                Byte low = read(addr), high = read(addr + 8);
+
+                for (int k = 0; k < 8; ++k)
+                {
+                    int x = spr_x + k;
+                    if (x >= ScanlineVisibleDots || (m_hideEdgeSprites && x < 8) || sprColors[x])
+                        continue;
+
+                    int x_shift = k;
+                    if ((attribute & 0x40) == 0) //If NOT flipping horizontally
+                        x_shift ^= 7;
+
+                    Byte color = ((low >> x_shift) & 1) | (((high >> x_shift) & 1) << 1);
+                    if (!color)
+                        continue;
+
+                    sprColors[x] = color | 0x10 | (attribute & 0x3) << 2;
+                    sprForeground[x] = !(attribute & 0x20);
+                    sprZero[x] = i == 0;
+                }
+            }
+        }
+
+        //Background a tile at a time, the pattern and attribute stay the same until coarse X moves on
+        for (int x = 0; x < ScanlineVisibleDots; )
+        {
+            int x_fine = (m_fineXScroll + x) % 8;
+            int run = std::min(8 - x_fine, ScanlineVisibleDots - x);
+
+            Byte low = 0, high = 0, palette = 0;
+
+            if (m_showBackground)
+            {
+                Byte tile = read(0x2000 | (m_dataAddress & 0x0FFF));
+
+                Address addr = (tile * 16) + ((m_dataAddress >> 12) & 0x7);
+                addr |= m_bgPage << 12;
+                low = read(addr);
+                high = read(addr + 8);
+
+                addr = 0x23C0 | (m_dataAddress & 0x0C00) | ((m_dataAddress >> 4) & 0x38)
+                            | ((m_dataAddress >> 2) & 0x07);
+                int shift = ((m_dataAddress >> 4) & 4) | (m_dataAddress & 2);
+                palette = ((read(addr) >> shift) & 0x3) << 2;
+            }
+
+            for (int k = 0; k < run; ++k, ++x, ++x_fine)
+            {
+                Byte bgColor = 0;
+                if (m_showBackground && (!m_hideEdgeBackground || x >= 8))
+                    bgColor = ((low >> (7 ^ x_fine)) & 1) | (((high >> (7 ^ x_fine)) & 1) << 1);
+
+                Byte paletteAddr = 0;
+
+                if (bgColor)
+                {
+                    paletteAddr = bgColor | palette;
+
+                    if (sprColors[x] && sprForeground[x])
+                        paletteAddr = sprColors[x];
+
+                    //Sprite-0 hit detection
+                    if (sprColors[x] && sprZero[x] && !m_sprZeroHit)
+                        m_sprZeroHit = true;
+                }
+                else
+                    paletteAddr = sprColors[x];
+
+                m_frameBuffer.setPixel(x, y, m_bus.readPalette(paletteAddr));
+            }
+
+            //Increment/wrap coarse X
+            if (m_showBackground && x_fine == 8)
+            {
+                if ((m_dataAddress & 0x001F) == 31) // if coarse X == 31
+                {
+                    m_dataAddress &= ~0x001F;          // coarse X = 0
+                    m_dataAddress ^= 0x0400;           // switch horizontal nametable
+                }
+                else
+                    m_dataAddress += 1;                // increment coarse X
+            }
+        }
+    }
+
+    bool PPU::canHitSpriteZero() const
+    {
+        return m_showBackground && m_showSprites && !m_sprZeroHit &&
+               std::find(m_scanlineSprites.begin(), m_scanlineSprites.end(), 0) != m_scanlineSprites.end();
+    }
+
+    int PPU::getStepsToVBlank() const
+    {
+        //Every scanline takes ScanlineEndCycle steps here, the pre-render line one less on odd frames
+        const int lineSteps = ScanlineEndCycle;
+        const int preRenderSteps = ScanlineEndCycle - 1;
+        const int renderToVBlank = (VisibleScanlines + 1) * lineSteps;
+
+        int steps = 0;
+        switch (m_pipelineState)
+        {
+            case PreRender:
+                steps = std::max(0, preRenderSteps + 1 - m_cycle) + renderToVBlank;
+                break;
+            case Render:
+                steps = (lineSteps + 1 - m_cycle) + (VisibleScanlines - 1 - m_scanline) * lineSteps + lineSteps;
+                break;
+            case PostRender:
+                steps = lineSteps + 1 - m_cycle;
+                break;
+            case VerticalBlank:
+                if (m_scanline == VisibleScanlines + 1 && m_cycle <= 1)
+                    steps = 0;
+                else
+                    steps = (lineSteps + 1 - m_cycle) + (FrameEndScanline - 1 - m_scanline) * lineSteps +
+                            preRenderSteps + renderToVBlank;
+                break;
+        }
+        return std::max(0, steps);
+    }
+
     Byte PPU::readOAM(Byte addr)
     {
         return m_spriteMemory[addr];
@@ -429,4 +654,88 @@ namespace sn
         return m_bus.read(addr);
     }
 
+    void PPU::saveState(StateWriter& writer) const
+    {
+        writer.write(m_spriteMemory);
+        writer.write(m_scanlineSprites);
+
+        writer.write(m_pipelineState);
+        writer.write(m_cycle);
+        writer.write(m_scanline);
+        writer.write(m_evenFrame);
+
+        writer.write(m_vblank);
+        writer.write(m_sprZeroHit);
+
+        writer.write(m_dataAddress);
+        writer.write(m_tempAddress);
+        writer.write(m_fineXScroll);
+        writer.write(m_firstWrite);
+        writer.write(m_dataBuffer);
+
+        writer.write(m_spriteDataAddress);
+
+        writer.write(m_longSprites);
+        writer.write(m_generateInterrupt);
+
+        writer.write(m_greyscaleMode);
+        writer.write(m_showSprites);
+        writer.write(m_showBackground);
+        writer.write(m_hideEdgeSprites);
+        writer.write(m_hideEdgeBackground);
+
+        writer.write(m_bgPage);
+        writer.write(m_sprPage);
+
+        writer.write(m_dataAddrIncrement);
+    }
+
+    bool PPU::loadState(StateReader& reader)
+    {
+        reader.read(m_spriteMemory);
+
+        //Holds 0 to 8 sprites, so its size is part of the state
+        std::uint64_t numScanlineSprites = 0;
+        if (reader.read(numScanlineSprites) && numScanlineSprites <= 64)
+        {
+            m_scanlineSprites.resize(numScanlineSprites);
+            reader.readBytes(m_scanlineSprites.data(), m_scanlineSprites.size());
+        }
+        else
+            return false;
+
+        reader.read(m_pipelineState);
+        reader.read(m_cycle);
+        reader.read(m_scanline);
+        reader.read(m_evenFrame);
+
+        reader.read(m_vblank);
+        reader.read(m_sprZeroHit);
+
+        reader.read(m_dataAddress);
+        reader.read(m_tempAddress);
+        reader.read(m_fineXScroll);
+        reader.read(m_firstWrite);
+        reader.read(m_dataBuffer);
+
+        reader.read(m_spriteDataAddress);
+
+        reader.read(m_longSprites);
+        reader.read(m_generateInterrupt);
+
+        reader.read(m_greyscaleMode);
+        reader.read(m_showSprites);
+        reader.read(m_showBackground);
+        reader.read(m_hideEdgeSprites);
+        reader.read(m_hideEdgeBackground);
+
+        reader.read(m_bgPage);
+        reader.read(m_sprPage);
+
+        reader.read(m_dataAddrIncrement);
+
+        m_pendingSteps = 0;
+
+        return reader.good();
+    }
 }
@@ -108,4 +108,27 @@ namespace sn
         return true;
     }
 
+    void PictureBus::saveState(StateWriter& writer) const
+    {
+        writer.write(m_RAM);
+        writer.write(m_palette);
+
+        writer.write(NameTable0);
+        writer.write(NameTable1);
+        writer.write(NameTable2);
+        writer.write(NameTable3);
+    }
+
+    bool PictureBus::loadState(StateReader& reader)
+    {
+        reader.read(m_RAM);
+        reader.read(m_palette);
+
+        reader.read(NameTable0);
+        reader.read(NameTable1);
+        reader.read(NameTable2);
+        reader.read(NameTable3);
+
+        return reader.good();
+    }
 }
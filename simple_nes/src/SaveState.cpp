@@ -0,0 +1,33 @@
+#include "SaveState.h"
+
+namespace sn
+{
+    void StateWriter::writeBytes(const Byte* bytes, std::size_t size)
+    {
+        m_state.data.insert(m_state.data.end(), bytes, bytes + size);
+    }
+
+    bool StateReader::readBytes(Byte* bytes, std::size_t size)
+    {
+        if (!m_good || m_state.data.size() - m_position < size)
+            return m_good = false;
+
+        if (size)
+            std::memcpy(bytes, m_state.data.data() + m_position, size);
+        m_position += size;
+        return true;
+    }
+
+    const Byte* StateReader::readView(std::size_t size)
+    {
+        if (!m_good || m_state.data.size() - m_position < size)
+        {
+            m_good = false;
+            return nullptr;
+        }
+
+        const Byte* view = m_state.data.data() + m_position;
+        m_position += size;
+        return view;
+    }
+}
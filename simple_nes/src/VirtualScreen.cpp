@@ -4,9 +4,8 @@
 
 namespace sn
 {
-    void VirtualScreen::create(unsigned int w, unsigned int h, float pixel_size, sf::Color color)
+    void VirtualScreen::create(unsigned int w, unsigned int h, float pixel_size)
     {
-        m_defaultColor = color;
         m_screenSize = {w, h};
 
         //m_sprite.setScale( m_screenSize.x * pixel_size, m_screenSize.y * pixel_size );
@@ -19,28 +18,12 @@ namespace sn
             m_texture.setSmooth( true );
         }
 
-        flushScreenData();
+        m_pixels.resize( FrameBuffer::Width * FrameBuffer::Height * 4 );
     }
 
-    void VirtualScreen::setPixel(std::size_t x, std::size_t y, sf::Color color)
+    std::shared_ptr<const FrameBuffer> VirtualScreen::getScreenData() const
     {
-        if (x > m_pixelColors->getSize().x || y > m_pixelColors->getSize().y)
-            return;
-
-        m_pixelColors->setPixel( x, y, color );
-    }
-
-    std::shared_ptr<sf::Image> VirtualScreen::getScreenData() const
-    {
-        return m_pixelColors;
-    }
-
-    std::shared_ptr<sf::Image> VirtualScreen::flushScreenData()
-    {
-        auto currentScreenData = getScreenData();
-        m_pixelColors = std::make_shared<sf::Image>();
-        m_pixelColors->create( m_screenSize.x, m_screenSize.y, m_defaultColor );
-        return currentScreenData;
+        return m_frameBuffer;
     }
 
     void VirtualScreen::setScreenPosition( sf::Vector2f pos )
@@ -48,10 +31,9 @@ namespace sn
         m_sprite.setPosition( pos );
     }
 
-    void VirtualScreen::setScreenData( std::shared_ptr<sf::Image> data )
+    void VirtualScreen::setScreenData( std::shared_ptr<const FrameBuffer> data )
     {
-        m_pixelColors = data;
-        m_texture.update( *m_pixelColors );
+        m_frameBuffer = data;
     }
 
     sf::Vector2u VirtualScreen::screenSize() const
@@ -61,9 +43,12 @@ namespace sn
 
     void VirtualScreen::draw(sf::RenderTarget& target, sf::RenderStates states) const
     {
-        m_texture.update( *getScreenData() );
+        if (m_frameBuffer)
+        {
+            m_frameBuffer->copyRGBA( m_pixels.data() );
+            m_texture.update( m_pixels.data(), FrameBuffer::Width, FrameBuffer::Height, 0, 0 );
+        }
         m_sprite.setTexture( m_texture );
         target.draw( m_sprite, states );
     }
 }
-
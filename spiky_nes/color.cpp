@@ -1,4 +1,12 @@
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <random>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif // __AVX__
 
 #include "spikey_nes.hpp"
 
@@ -438,6 +446,182 @@ namespace spkn
         }
     }
 
+    template< typename PixelAt >
+    void
+    __FrameSobelEdgeDetectionToLightness( PixelAt pixelAt, size_t width, size_t height, size_t newWidth, size_t newHeight, std::vector<float>& scratch, double * destination, double scale )
+    {
+        // pixelAt( x, y ) gives the 4 RGBA bytes of a source pixel
+
+        // the arithmetic mirrors ResizeImage, ConvertRGBtoL and __SobelKernelOp operation for operation, so the output is bit identical
+
+        auto lerp =  []( float s, float e, float t ) -> float { return s + ( e - s ) * t; };
+        auto blerp = [&]( float c00, float c10, float c01, float c11, float tx, float ty ) -> float { return lerp( lerp( c00, c10, tx ), lerp( c01, c11, tx ), ty ); };
+
+        if( scratch.size() < newWidth * newHeight )
+        {
+            scratch.resize( newWidth * newHeight );
+        }
+
+        float * lightness = scratch.data();
+
+        // pass 1: bilinear resample and lightness
+        for( size_t y = 0; y < newHeight; ++y )
+        {
+            double gy = y / (double)(newHeight) * (height-1);
+            size_t gyi = (size_t)gy;
+            float ty = float( gy - gyi );
+
+            float * lightness_row = lightness + y * newWidth;
+
+            for( size_t x = 0; x < newWidth; ++x )
+            {
+                double gx = x / (double)(newWidth) * (width-1);
+                size_t gxi = (size_t)gx;
+                float tx = float( gx - gxi );
+
+                const sf::Uint8 * c00 = pixelAt( gxi, gyi );
+                const sf::Uint8 * c10 = pixelAt( gxi + 1, gyi );
+                const sf::Uint8 * c01 = pixelAt( gxi, gyi + 1 );
+                const sf::Uint8 * c11 = pixelAt( gxi + 1, gyi + 1 );
+
+                uint8_t r = blerp( c00[0], c10[0], c01[0], c11[0], tx, ty );
+                uint8_t g = blerp( c00[1], c10[1], c01[1], c11[1], tx, ty );
+                uint8_t b = blerp( c00[2], c10[2], c01[2], c11[2], tx, ty );
+
+                uint8_t min = std::min( std::min( r, g ), b );
+                uint8_t max = std::max( std::max( r, g ), b );
+
+                lightness_row[ x ] = ( max/255.0f + min/255.0f ) / 2.0f;
+            }
+        }
+
+        // pass 2: sobel magnitude and its bounds
+        neat::MinMax<double> minmax;
+
+        auto sobel = [&]( size_t x, size_t y ) -> float
+        {
+            size_t xw = x ? x - 1 : 0, xe = std::min( x + 1, newWidth - 1 );
+            size_t yn = y ? y - 1 : 0, ys = std::min( y + 1, newHeight - 1 );
+
+            const float * n = lightness + yn * newWidth;
+            const float * c = lightness + y * newWidth;
+            const float * s = lightness + ys * newWidth;
+
+            float gx = ( n[xe] + c[xe] + c[xe] + s[xe] ) - ( n[xw] + c[xw] + c[xw] + s[xw] );
+            float gy = ( s[xw] + s[x] + s[x] + s[xe] ) - ( n[xw] + n[x] + n[x] + n[xe] );
+
+            return sqrt( gx * gx + gy * gy );
+        };
+
+        for( size_t y = 0; y < newHeight; ++y )
+        {
+            double * destination_row = destination + y * newWidth;
+
+            if( !y || y == newHeight - 1 || newWidth < 3 )
+            {
+                for( size_t x = 0; x < newWidth; ++x )
+                {
+                    float value = sobel( x, y );
+                    minmax.expand( value );
+                    destination_row[ x ] = value;
+                }
+                continue;
+            }
+
+            const float * n = lightness + ( y - 1 ) * newWidth;
+            const float * c = lightness + y * newWidth;
+            const float * s = lightness + ( y + 1 ) * newWidth;
+
+            {
+                float value = sobel( 0, y );
+                minmax.expand( value );
+                destination_row[ 0 ] = value;
+            }
+
+            size_t x = 1;
+
+#if defined(__AVX__)
+            // eight interior pixels at a time, same operation order as the scalar path
+            if( x + 9 <= newWidth )
+            {
+                __m256 row_min = _mm256_set1_ps( std::numeric_limits<float>::max() );
+                __m256 row_max = _mm256_set1_ps( std::numeric_limits<float>::lowest() );
+
+                for( ; x + 9 <= newWidth; x += 8 )
+                {
+                    __m256 NW = _mm256_loadu_ps( n + x - 1 ), N = _mm256_loadu_ps( n + x ), NE = _mm256_loadu_ps( n + x + 1 );
+                    __m256 W  = _mm256_loadu_ps( c + x - 1 ),                                E = _mm256_loadu_ps( c + x + 1 );
+                    __m256 SW = _mm256_loadu_ps( s + x - 1 ), S = _mm256_loadu_ps( s + x ), SE = _mm256_loadu_ps( s + x + 1 );
+
+                    __m256 gx = _mm256_sub_ps( _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( NE, E ), E ), SE ), _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( NW, W ), W ), SW ) );
+                    __m256 gy = _mm256_sub_ps( _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( SW, S ), S ), SE ), _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( NW, N ), N ), NE ) );
+
+                    __m256 value = _mm256_sqrt_ps( _mm256_add_ps( _mm256_mul_ps( gx, gx ), _mm256_mul_ps( gy, gy ) ) );
+
+                    row_min = _mm256_min_ps( row_min, value );
+                    row_max = _mm256_max_ps( row_max, value );
+
+                    _mm256_storeu_pd( destination_row + x,     _mm256_cvtps_pd( _mm256_castps256_ps128( value ) ) );
+                    _mm256_storeu_pd( destination_row + x + 4, _mm256_cvtps_pd( _mm256_extractf128_ps( value, 1 ) ) );
+                }
+
+                alignas( 32 ) float lanes_min[ 8 ];
+                alignas( 32 ) float lanes_max[ 8 ];
+                _mm256_store_ps( lanes_min, row_min );
+                _mm256_store_ps( lanes_max, row_max );
+
+                for( size_t i = 0; i < 8; ++i )
+                {
+                    minmax.expand( lanes_min[ i ] );
+                    minmax.expand( lanes_max[ i ] );
+                }
+            }
+#endif // __AVX__
+
+            for( ; x < newWidth - 1; ++x )
+            {
+                float gx = ( n[x+1] + c[x+1] + c[x+1] + s[x+1] ) - ( n[x-1] + c[x-1] + c[x-1] + s[x-1] );
+                float gy = ( s[x-1] + s[x] + s[x] + s[x+1] ) - ( n[x-1] + n[x] + n[x] + n[x+1] );
+
+                float value = sqrt( gx * gx + gy * gy );
+                minmax.expand( value );
+                destination_row[ x ] = value;
+            }
+
+            {
+                float value = sobel( newWidth - 1, y );
+                minmax.expand( value );
+                destination_row[ newWidth - 1 ] = value;
+            }
+        }
+
+        // pass 3: normalize in place
+        double range = minmax.range();
+        for( size_t i = 0; i < newWidth * newHeight; ++i )
+        {
+            double& v = destination[ i ];
+            v = ( ( v - minmax.min ) / range ) * scale;
+        }
+    }
+
+    void
+    FrameSobelEdgeDetectionToLightness( const sf::Uint8 * pixels, size_t width, size_t height, size_t newWidth, size_t newHeight, std::vector<float>& scratch, double * destination, double scale )
+    {
+        auto pixelAt = [&]( size_t x, size_t y ) -> const sf::Uint8 * { return pixels + ( y * width + x ) * 4; };
+
+        __FrameSobelEdgeDetectionToLightness( pixelAt, width, height, newWidth, newHeight, scratch, destination, scale );
+    }
+
+    void
+    FrameSobelEdgeDetectionToLightness( const sn::FrameBuffer& frame, size_t newWidth, size_t newHeight, std::vector<float>& scratch, double * destination, double scale )
+    {
+        const uint8_t * indices = frame.getFrame();
+
+        auto pixelAt = [&]( size_t x, size_t y ) -> const sf::Uint8 * { return sn::FrameBuffer::getPaletteRGBA( indices[ y * sn::FrameBuffer::Width + x ] ); };
+
+        __FrameSobelEdgeDetectionToLightness( pixelAt, sn::FrameBuffer::Width, sn::FrameBuffer::Height, newWidth, newHeight, scratch, destination, scale );
+    }
+
     sf::Image
     ResizeImage( const sf::Image& image, size_t width, size_t height )
     {
@@ -487,32 +671,28 @@ namespace spkn
 
         size_t newWidth = width;
         size_t newHeight= height;
-        size_t x = 0;
-        size_t y = 0;
-        for( ; y < newHeight; ++x )
+        for( size_t y = 0; y < newHeight; ++y )
         {
-            if( x > newWidth )
+            for( size_t x = 0; x < newWidth; ++x )
             {
-                x = 0;
-                y++;
+                double gx = x / (double)(newWidth) * (image.getSize().x-1);
+                double gy = y / (double)(newHeight) * (image.getSize().y-1);
+                size_t gxi = (size_t)gx;
+                size_t gyi = (size_t)gy;
+
+                sf::Color c00 = image.getPixel( gxi, gyi );
+                sf::Color c10 = image.getPixel( gxi + 1, gyi );
+                sf::Color c01 = image.getPixel( gxi, gyi + 1 );
+                sf::Color c11 = image.getPixel( gxi + 1, gyi + 1 );
+
+                sf::Color result = { 0, 0, 0, 0 };
+                result.r = blerp( c00.r, c10.r, c01.r, c11.r, gx - gxi, gy - gyi);
+                result.g = blerp( c00.g, c10.g, c01.g, c11.g, gx - gxi, gy - gyi);
+                result.b = blerp( c00.b, c10.b, c01.b, c11.b, gx - gxi, gy - gyi);
+                result.a = blerp( c00.a, c10.a, c01.a, c11.a, gx - gxi, gy - gyi);
+
+                out.setPixel( x, y, result );
             }
-            double gx = x / (double)(newWidth) * (image.getSize().x-1);
-            double gy = y / (double)(newHeight) * (image.getSize().y-1);
-            size_t gxi = (size_t)gx;
-            size_t gyi = (size_t)gy;
-
-            sf::Color c00 = image.getPixel( gxi, gyi );
-            sf::Color c10 = image.getPixel( gxi + 1, gyi );
-            sf::Color c01 = image.getPixel( gxi, gyi + 1 );
-            sf::Color c11 = image.getPixel( gxi + 1, gyi + 1 );
-
-            sf::Color result = { 0, 0, 0, 0 };
-            result.r = blerp( c00.r, c10.r, c01.r, c11.r, gx - gxi, gy - gyi);
-            result.g = blerp( c00.g, c10.g, c01.g, c11.g, gx - gxi, gy - gyi);
-            result.b = blerp( c00.b, c10.b, c01.b, c11.b, gx - gxi, gy - gyi);
-            result.a = blerp( c00.a, c10.a, c01.a, c11.a, gx - gxi, gy - gyi);
-
-            out.setPixel( x, y, result );
         }
 
         return out;
@@ -738,4 +918,98 @@ namespace spkn
 
         return image;
     }
+
+    bool
+    TestFrameSobelEdgeDetectionToLightness( size_t numFrames, std::ostream& out )
+    {
+        const size_t width = sn::FrameBuffer::Width;
+        const size_t height = sn::FrameBuffer::Height;
+
+        // the sizes FitnessCalculator uses for the common downscale ratios, plus some odd ones
+        const std::vector< std::pair< size_t, size_t > > sizes = { { 128, 120 }, { 64, 60 }, { 32, 30 }, { 16, 15 }, { 8, 7 }, { 17, 13 }, { 3, 3 }, { 2, 2 }, { 1, 1 } };
+
+        std::mt19937 rng( 0x5EED );
+        std::uniform_int_distribution< uint32_t > byte( 0, 255 );
+
+        auto makeFrame = [&]( size_t frame ) -> std::shared_ptr<sn::FrameBuffer>
+        {
+            auto buffer = std::make_shared<sn::FrameBuffer>();
+
+            // a few structured frames first, then noise over a few palette entries like a real screen
+            std::vector< uint8_t > palette( 4 + byte( rng ) % 12 );
+            for( auto& c : palette )
+            {
+                c = byte( rng ) & 0x3F;
+            }
+
+            for( size_t y = 0; y < height; ++y )
+            {
+                for( size_t x = 0; x < width; ++x )
+                {
+                    uint8_t c;
+                    switch( frame )
+                    {
+                        case 0:  c = 0x22; break; // uniform sky, normalizes to NaN
+                        case 1:  c = ( x / 4 + y / 4 ) & 0x3F; break;
+                        case 2:  c = ( ( x / 8 + y / 8 ) & 1 ) ? 0x30 : 0x0F; break;
+                        default: c = ( byte( rng ) & 3 ) ? palette[ ( x / 16 + y / 16 * 7 ) % palette.size() ] : palette[ byte( rng ) % palette.size() ]; break;
+                    }
+                    buffer->setPixel( x, y, c );
+                }
+            }
+
+            buffer->swap();
+
+            return buffer;
+        };
+
+        std::vector< float > scratch;
+        std::vector< sf::Uint8 > pixels( width * height * 4 );
+        size_t numFailures = 0;
+
+        auto compare = [&]( const std::vector< double >& expected, const std::vector< double >& actual, size_t frame, const std::pair< size_t, size_t >& size, const char * path )
+        {
+            for( size_t i = 0; i < expected.size(); ++i )
+            {
+                bool same = ( expected[ i ] == actual[ i ] ) || ( std::isnan( expected[ i ] ) && std::isnan( actual[ i ] ) );
+                if( !same )
+                {
+                    out << path << " frame " << frame << " at " << size.first << "x" << size.second << ": index " << i << " expected " << expected[ i ] << " got " << actual[ i ] << "\n";
+                    ++numFailures;
+                    return;
+                }
+            }
+        };
+
+        for( size_t frame = 0; frame < numFrames + 3; ++frame )
+        {
+            auto buffer = makeFrame( frame );
+
+            buffer->copyRGBA( pixels.data() );
+            sf::Image image;
+            image.create( width, height, pixels.data() );
+
+            for( const auto& size : sizes )
+            {
+                size_t count = size.first * size.second;
+
+                // padded with sentinels on both ends so writes outside the frame are caught
+                std::vector< double > expected( count + 2, -1.0 );
+                std::vector< double > actual( count + 2, -1.0 );
+
+                ImageSobelEdgeDetectionToLightness( ResizeImage( image, size.first, size.second ), expected, 1.0, 1 );
+
+                FrameSobelEdgeDetectionToLightness( pixels.data(), width, height, size.first, size.second, scratch, actual.data() + 1, 1.0 );
+                compare( expected, actual, frame, size, "rgba" );
+
+                std::fill( actual.begin(), actual.end(), -1.0 );
+                FrameSobelEdgeDetectionToLightness( *buffer, size.first, size.second, scratch, actual.data() + 1, 1.0 );
+                compare( expected, actual, frame, size, "palette" );
+            }
+        }
+
+        out << ( numFailures ? "FAILED" : "passed" ) << ": " << ( numFrames + 3 ) * sizes.size() * 2 << " frame preprocessing comparisons, " << numFailures << " mismatched\n";
+
+        return numFailures == 0;
+    }
 }
@@ -1,8 +1,12 @@
 #ifndef SPKN_COLOR_HPP_INCLUDED
 #define SPKN_COLOR_HPP_INCLUDED
 
+#include <iosfwd>
+
 #include <SFML/Graphics.hpp>
 
+#include "../simple_nes/include/FrameBuffer.h"
+
 namespace spkn
 {
     struct ColorHSL
@@ -26,6 +30,14 @@ namespace spkn
     void ImageLaplacianEdgeDetectionToLightness( const sf::Image& image, std::vector<double>& destination, double scale, size_t startPos );
     void ImageSobelEdgeDetectionToLightness( const sf::Image& image, std::vector<double>& destination, double scale, size_t startPos );
 
+    // ImageSobelEdgeDetectionToLightness( ResizeImage( image, newWidth, newHeight ), ... ) in one go, straight from the RGBA pixels
+    //   gives the same output, allocates nothing once scratch is big enough
+    void FrameSobelEdgeDetectionToLightness( const sf::Uint8 * pixels, size_t width, size_t height, size_t newWidth, size_t newHeight, std::vector<float>& scratch, double * destination, double scale );
+    void FrameSobelEdgeDetectionToLightness( const sn::FrameBuffer& frame, size_t newWidth, size_t newHeight, std::vector<float>& scratch, double * destination, double scale );
+
+    // golden test of FrameSobelEdgeDetectionToLightness against the functions it replaces, on generated frames
+    bool TestFrameSobelEdgeDetectionToLightness( size_t numFrames, std::ostream& out );
+
     sf::Image ResizeImage( const sf::Image& image, size_t width, size_t height );
     sf::Image DownsizeImage_Multiple( const sf::Image& image, size_t downscaleFactor );
 
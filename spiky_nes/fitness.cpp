@@ -1,4 +1,5 @@
 #include <iostream>
+#include <sstream>
 #include <cassert>
 
 #include "spikey_nes.hpp"
@@ -6,7 +7,17 @@
 
 namespace spkn
 {
-    FitnessCalculator::FitnessCalculator( std::shared_ptr< neat::NetworkPhenotype > net, const std::string& rom_path, uint64_t stepsPerFrame, size_t colorRings, double maxActivationWeight, size_t downscaleRatio, double APM, std::shared_ptr<Rand::RandomFunctor> _rand )
+    namespace
+    {
+        // stopTest ends a run after this many frames without a new button press, or without the screen moving
+        const uint64_t maxVBlanksWithoutButtonpress = 15 * 60;
+        const uint64_t maxVBlanksWithoutMoving = 30 * 60;
+
+        // the longest cycle of game states looked for, shorter than both of the limits above
+        const uint64_t maxLoopPeriod = 10 * 60;
+    }
+
+    FitnessCalculator::FitnessCalculator( std::shared_ptr< neat::NetworkPhenotype > net, std::shared_ptr< const sn::Cartridge > cartridge, std::shared_ptr< const sn::SaveState > startState, uint64_t stepsPerFrame, size_t colorRings, double maxActivationWeight, size_t downscaleRatio, double APM, std::shared_ptr<Rand::RandomFunctor> _rand )
          : neat::FitnessCalculator( net ),
         networkStepsPerFrame( stepsPerFrame ),
         emulator(),
@@ -18,6 +29,14 @@ namespace spkn
         numVBlanksWithoutButtonpress( 0 ),
         lastKnownScreenPosition( 0.0 ),
         numVBlanksWithoutMoving( 0 ),
+        stateLoops( maxLoopPeriod ),
+        loopSkippedVBlanks( 0 ),
+        loopSkippedPulses( 0.0L ),
+        startVBlanks( 0 ),
+        startScore( 0 ),
+        startWorldLevel( 0 ),
+        startLives( 0 ),
+        currentWorldLevel( 0 ),
         gameStateExtractor( emulator ),
         random( _rand ),
         maxScreenPosPerLevel(),
@@ -25,6 +44,7 @@ namespace spkn
         controllStopped( false ),
         networkOutputCallbacks(),
         screenInput(),
+        screenScratch(),
         spiralRings( colorRings ),
         activationMaxValue( maxActivationWeight ),
         NESpixelsPerNetworkPixel( downscaleRatio ),
@@ -34,15 +54,23 @@ namespace spkn
 
         screenInput.resize( numInputs(), 0.0 );
 
-        // init the emulator with the rom
-        emulator.init( rom_path );
-        gameStateExtractor.InitGameToRunning();
+        // init the emulator with the rom, and skip straight to the point the player has control
+        assert( cartridge != nullptr && startState != nullptr );
+        if( !emulator.init( *cartridge ) || !emulator.loadState( *startState ) )
+        {
+            std::cerr << "FitnessCalculator: could not restore the emulator start state\n";
+        }
+        startVBlanks = emulator.getNumVBlank();
+        startScore = gameStateExtractor.Score_Mario();
+        startWorldLevel = gameStateExtractor.WorldLevel();
+        startLives = gameStateExtractor.Lives();
+        currentWorldLevel = highestWorldLevel = startWorldLevel;
 
         // hook network output to the controller state
         /*while( networkOutputCallbacks.size() < getNumOutputNodes() )
         {
             size_t i = networkOutputCallbacks.size();
-            auto func = [&,i](const spnn::neuron&){ controllerSet = controllerState[i] = true; };
+            auto func = [&,i](const spnn::compiled_neuron&){ controllerSet = controllerState[i] = true; };
             networkOutputCallbacks.push_back( func );
             if( i == size_t(sn::Controller::Start) || i == size_t(sn::Controller::Select) )
                 networkOutputCallbacks.back() = nullptr;
@@ -50,29 +78,20 @@ namespace spkn
 
         // TODO(dot##11/10/2020): Create ControllerStateSanityFilter class or something along those lines
 
-        networkOutputCallbacks.emplace_back( [&](const spnn::neuron&){ activateButton( size_t( sn::Controller::A ) ); } );
-        networkOutputCallbacks.emplace_back( [&](const spnn::neuron&){ activateButton( size_t( sn::Controller::B ) ); } );
-        networkOutputCallbacks.emplace_back( [&](const spnn::neuron&){ activateButton( size_t( sn::Controller::Up ) ); } );
-        networkOutputCallbacks.emplace_back( [&](const spnn::neuron&){ activateButton( size_t( sn::Controller::Down ) ); } );
-        networkOutputCallbacks.emplace_back( [&](const spnn::neuron&){ activateButton( size_t( sn::Controller::Left ) ); } );
-        networkOutputCallbacks.emplace_back( [&](const spnn::neuron&){ activateButton( size_t( sn::Controller::Right ) ); } );
+        networkOutputCallbacks.emplace_back( [&](const spnn::compiled_neuron&){ activateButton( size_t( sn::Controller::A ) ); } );
+        networkOutputCallbacks.emplace_back( [&](const spnn::compiled_neuron&){ activateButton( size_t( sn::Controller::B ) ); } );
+        networkOutputCallbacks.emplace_back( [&](const spnn::compiled_neuron&){ activateButton( size_t( sn::Controller::Up ) ); } );
+        networkOutputCallbacks.emplace_back( [&](const spnn::compiled_neuron&){ activateButton( size_t( sn::Controller::Down ) ); } );
+        networkOutputCallbacks.emplace_back( [&](const spnn::compiled_neuron&){ activateButton( size_t( sn::Controller::Left ) ); } );
+        networkOutputCallbacks.emplace_back( [&](const spnn::compiled_neuron&){ activateButton( size_t( sn::Controller::Right ) ); } );
 
         while( networkOutputCallbacks.size() < getNumOutputNodes() )
         {
             networkOutputCallbacks.emplace_back( nullptr );
         }
 
-        // hook the emulator input to the controller state
-        std::vector<std::function<bool(void)>> controllerCallbacks;
-        while( controllerCallbacks.size() < size_t(sn::Controller::TotalButtons) )
-        {
-            size_t i = controllerCallbacks.size();
-            controllerCallbacks.push_back( [&,i]{ return controllerState[i]; } );
-        }
-
-        // hook the callbacks to the emulator, and disable the start and select buttons
-        emulator.setControllerCallbacks( controllerCallbacks, {} );
-        emulator.setControllerCallbackMap( { { sn::Controller::Start, []{return false;} }, { sn::Controller::Select, []{return false;} }, }, {} );
+        // the controller state is handed to the emulator as one byte each frame, see testTick
+        emulator.setControllerState( 0, 0 );
     }
 
     FitnessCalculator::~FitnessCalculator()
@@ -97,7 +116,7 @@ namespace spkn
         return size_t(sn::Controller::TotalButtons) - 2; // exclude start and select
     }
 
-    std::shared_ptr<sf::Image>
+    std::shared_ptr<const sn::FrameBuffer>
     FitnessCalculator::getScreenData() const
     {
         return emulator.getScreenData();
@@ -106,7 +125,7 @@ namespace spkn
     uint64_t
     FitnessCalculator::getNumVBlank() const
     {
-        return emulator.getNumVBlank();
+        return emulator.getNumVBlank() - startVBlanks;
     }
 
     long double
@@ -116,7 +135,7 @@ namespace spkn
 
         long double fitness = 0.0L;
         {
-            long double minutes_played                 = (long double)( getNumVBlank() ) / 3600.0L;
+            long double minutes_played                 = (long double)( getNumVBlank() + loopSkippedVBlanks ) / 3600.0L;
 
             fitness -= minutes_played * points_per_screen;
             //fitness -= ( pow( minutes_played               + 1.0L, 1.0L / 2.0L ) - 1.0L ) * points_per_screen;
@@ -125,10 +144,12 @@ namespace spkn
         long double game_fitness = 0.0L;
         {
 
-            long double game_score       = (long double)( gameStateExtractor.Score_High() );
-            long double world_score      = (long double)( highestWorldLevel - 11 ); // BCD ex. World 3-2 would be 32
+            // all relative to the start state, from the start of the game World 1-1 and 3 lives.
+            //   the top score is whatever the network that reached the start state made, so the player's score is used
+            long double game_score       = (long double)( gameStateExtractor.Score_Mario() ) - (long double)( startScore );
+            long double world_score      = (long double)( highestWorldLevel ) - (long double)( startWorldLevel ); // BCD ex. World 3-2 would be 32
             long double level_count      = (long double)( std::max<size_t>( 1, maxScreenPosPerLevel.size() ) );
-            long double lives_score      = ( !controllStopped ? (long double)( gameStateExtractor.Lives() - 2 ) : 0.0L );
+            long double lives_score      = ( !controllStopped ? (long double)( gameStateExtractor.Lives() ) - (long double)( startLives ) + 1.0L : 0.0L );
             long double traversal_score  = std::accumulate( maxScreenPosPerLevel.begin(), maxScreenPosPerLevel.end(), 0.0L, []( const auto& a, const auto& b ){ return a + b.second; } );
 
             game_fitness += game_score      * points_per_screen * 0.0001L;
@@ -144,8 +165,12 @@ namespace spkn
 
         long double net_fitness = 0.0L;
         {
-            long double network_activity_per_neuron    = ( (long double)( Network()->PulsesProcessed() ) / (long double)( Network()->numNeurons()  ) ) / ( (long double)( Network()->Time() ) / (long double)( networkStepsPerFrame ) );
-            long double network_activity_per_synapse   = ( (long double)( Network()->PulsesProcessed() ) / (long double)( Network()->numSynapses() ) ) / ( (long double)( Network()->Time() ) / (long double)( networkStepsPerFrame ) );
+            // a skipped loop counts as played out, at the rate the network ran at in the loop
+            long double network_pulses                 = (long double)( getNetworkPulses() ) + loopSkippedPulses;
+            long double network_frames                 = (long double)( Network()->Time() ) / (long double)( networkStepsPerFrame ) + (long double)( loopSkippedVBlanks );
+
+            long double network_activity_per_neuron    = ( network_pulses / (long double)( Network()->numNeurons()  ) ) / network_frames;
+            long double network_activity_per_synapse   = ( network_pulses / (long double)( Network()->numSynapses() ) ) / network_frames;
             long double network_complexity             = (long double)( Network()->numSynapses() ) / (long double)( Network()->numNeurons() );
 
             net_fitness -= ( pow( network_activity_per_neuron  + 1.0L, 1.0L / 3.0L ) - 1.0L ) * points_per_screen;
@@ -168,17 +193,18 @@ namespace spkn
     bool
     FitnessCalculator::stopTest() const
     {
-        if( numVBlanksWithoutButtonpress / 60.0 >= 15.0 )
+        if( numVBlanksWithoutButtonpress >= maxVBlanksWithoutButtonpress )
         {
             controllStopped = true;
             return true;
         }
-        if( numVBlanksWithoutMoving / 60.0 >= 30.0 )
+        if( numVBlanksWithoutMoving >= maxVBlanksWithoutMoving )
         {
             controllStopped = true;
             return true;
         }
-        if( gameStateExtractor.Lives() > 2 )
+        // until the first life lost
+        if( gameStateExtractor.Lives() >= startLives )
         {
             return false;
         }
@@ -194,6 +220,13 @@ namespace spkn
 
             actionsAvailable = std::min( 12.0L, actionsAvailable );
 
+            // only draw the frames the network is shown, one is read if an input check comes before the next frame is stepped
+            const uint64_t inputCadence = getInputValueCheckCadence();
+            const bool screenRead = inputCadence != 0 && ( time / inputCadence + 1 ) * inputCadence <= time + networkStepsPerFrame;
+            emulator.setRenderMode( screenRead ? sn::DrawPixels : sn::SkipPixels );
+
+            sn::Byte buttons = getControllerButtons();
+            emulator.setControllerState( 0, buttons );
             emulator.stepFrame();
             resetControllerState();
 
@@ -203,6 +236,16 @@ namespace spkn
             double current_screen_position = gameStateExtractor.ScreenPosition();
             maxScreenPosPerLevel[ worldLevel ] = std::max( maxScreenPosPerLevel[ worldLevel ], current_screen_position );
 
+            // the first frame of a new level, a place later networks can start from
+            if( worldLevel != currentWorldLevel )
+            {
+                currentWorldLevel = worldLevel;
+                if( parentFactory != nullptr )
+                {
+                    parentFactory->addLevelStartState( worldLevel, emulator );
+                }
+            }
+
             if( lastKnownScreenPosition != current_screen_position )
             {
                 numVBlanksWithoutMoving = 0;
@@ -212,6 +255,12 @@ namespace spkn
                 ++numVBlanksWithoutMoving;
             }
             lastKnownScreenPosition = current_screen_position;
+
+            // a perturbed run gets different input every frame, so the network can not be taken to repeat with the game
+            if( random == nullptr && stateLoops.addState( getLoopStateHash( buttons ), getNetworkPulses() ) )
+            {
+                skipRepeatingLoop();
+            }
         }
     }
 
@@ -241,8 +290,9 @@ namespace spkn
             //ImageToSingle( ResizeImage( *emuScreen, scaled_width, scaled_height ), spiralRings, true, screenInput, activationMaxValue, 0 );
 
             // fast and good enough
-            // downscale then edge-find
-            ImageSobelEdgeDetectionToLightness( ResizeImage( *emuScreen, scaled_width, scaled_height ), screenInput, activationMaxValue, 0 );
+            // downscale then edge-find, fused into one pass over the frame
+            FrameSobelEdgeDetectionToLightness( *emuScreen, scaled_width, scaled_height, screenScratch, screenInput.data(), activationMaxValue );
+            //ImageSobelEdgeDetectionToLightness( ResizeImage( *emuScreen, scaled_width, scaled_height ), screenInput, activationMaxValue, 0 );
 
             // slower but less aliasing
             //ImageSobelEdgeDetectionToLightness( DownsizeImage_Multiple( *emuScreen, downsizeSize ), screenInput, activationMaxValue, 0 );
@@ -316,6 +366,21 @@ namespace spkn
         }
     }
 
+    sn::Byte
+    FitnessCalculator::getControllerButtons() const
+    {
+        sn::Byte buttons = 0;
+        for( size_t i = 0; i < controllerState.size(); ++i )
+        {
+            // the start and select buttons are disabled
+            if( controllerState[ i ] && i != size_t(sn::Controller::Start) && i != size_t(sn::Controller::Select) )
+            {
+                buttons |= sn::Byte( 1 << i );
+            }
+        }
+        return buttons;
+    }
+
     void
     FitnessCalculator::activateButton( size_t button )
     {
@@ -331,6 +396,49 @@ namespace spkn
         }
     }
 
+    uint64_t
+    FitnessCalculator::getLoopStateHash( sn::Byte buttons ) const
+    {
+        // the game and the buttons pressed on it, the network's own state is taken to repeat with them,
+        // hashing the neurons and the pulse queue every frame costs more than the skipped frames save
+        neat::ContentHasher hasher;
+
+        hasher.add( gameStateExtractor.LoopStateHash() );
+        hasher.add( buttons );
+
+        // held buttons cost no actions, start and select included
+        for( bool held : previousControllerState )
+        {
+            hasher.add( held );
+        }
+
+        // split exactly into two doubles, the padding of a long double is not part of its value
+        const double actionsHigh = double( actionsAvailable );
+        hasher.add( actionsHigh );
+        hasher.add( double( actionsAvailable - actionsHigh ) );
+
+        return hasher.value();
+    }
+
+    uint64_t
+    FitnessCalculator::getNetworkPulses() const
+    {
+        // the input values count as the pulses they used to be sent as, the input port does not put them through the pulse queue
+        return Network()->PulsesProcessed() + Network()->InputsProcessed();
+    }
+
+    void
+    FitnessCalculator::skipRepeatingLoop()
+    {
+        // skip straight to the stopTest limit the loop runs into, the level timer is not part of the loop,
+        // so a run that would time out first is played out
+        const uint64_t period = stateLoops.Period();
+        const uint64_t skipped = SkipLoopToIdleLimit( period, gameStateExtractor.FramesUntilTimeUp(), { { &numVBlanksWithoutButtonpress, maxVBlanksWithoutButtonpress }, { &numVBlanksWithoutMoving, maxVBlanksWithoutMoving } } );
+
+        loopSkippedVBlanks += skipped;
+        loopSkippedPulses += (long double)( stateLoops.TotalOverPeriod() ) * (long double)( skipped ) / (long double)( period );
+    }
+
     void
     FitnessCalculator::setParentFactory( const FitnessFactory * factory )
     {
@@ -344,13 +452,20 @@ namespace spkn
 
     // fitness factory
 
-    FitnessFactory::FitnessFactory( const std::string& mario_rom, std::shared_ptr<PreviewWindow> window, double maxWeightForActivation, double APM, std::shared_ptr<Rand::RandomFunctor> _rand, size_t runs_to_average, uint64_t steps_per_frame, size_t color_rings, size_t downscaleRatio )
+    FitnessFactory::FitnessFactory( const std::string& mario_rom, std::shared_ptr<PreviewWindow> window, double maxWeightForActivation, double APM, std::shared_ptr<Rand::RandomFunctor> _rand, size_t runs_to_average, uint64_t steps_per_frame, size_t color_rings, size_t downscaleRatio, size_t level_start_runs )
          :
         rom_path( mario_rom ),
+        cartridge( nullptr ),
+        startState( nullptr ),
         stepsPerFrame( steps_per_frame ),
         colorRings( color_rings ),
         random( _rand ),
+        perturbSeed( _rand ? _rand->Int() : 0 ),
         num_times_to_test( runs_to_average ),
+        numLevelStartRuns( level_start_runs ),
+        levelStartStatesMutex(),
+        levelStartStates(),
+        newLevelStartStates(),
         totalVBlanks( 0 ),
         individualsProcessed( 0 ),
         generationsProcessed( 0 ),
@@ -359,7 +474,21 @@ namespace spkn
         actionsPerMinute( APM ),
         NESpixelsPerNetworkPixel( downscaleRatio )
     {
-        /*  */
+        // read the rom and boot the game once, every test starts from a copy of this state
+        cartridge = sn::CartridgeRegistry::load( rom_path );
+        if( !cartridge )
+        {
+            std::cerr << "FitnessFactory: could not load rom \"" << rom_path << "\"\n";
+            cartridge = std::make_shared< const sn::Cartridge >();
+            startState = std::make_shared< const sn::SaveState >();
+            return;
+        }
+
+        sn::Emulator emulator;
+        emulator.init( *cartridge );
+        GameState_SuperMarioBros( emulator ).InitGameToRunning();
+
+        startState = std::make_shared< const sn::SaveState >( emulator.saveState() );
     }
 
     FitnessFactory::~FitnessFactory()
@@ -390,6 +519,12 @@ namespace spkn
     void
     FitnessFactory::incrementGeneration()
     {
+        {
+            std::lock_guard< std::mutex > lock( levelStartStatesMutex );
+            levelStartStates.insert( newLevelStartStates.begin(), newLevelStartStates.end() );
+            newLevelStartStates.clear();
+        }
+
         ++generationsProcessed;
         if( preview_window )
         {
@@ -398,11 +533,31 @@ namespace spkn
         }
     }
 
+    size_t
+    FitnessFactory::numLevelStartStates() const
+    {
+        std::lock_guard< std::mutex > lock( levelStartStatesMutex );
+        return levelStartStates.size();
+    }
+
     std::shared_ptr< neat::FitnessCalculator >
     FitnessFactory::getNewFitnessCalculator( std::shared_ptr< neat::NetworkPhenotype > net, size_t testNum ) const
     {
+        return getNewFitnessCalculatorFor( net, testNum, generationsProcessed, 0 );
+    }
+
+    std::shared_ptr< neat::FitnessCalculator >
+    FitnessFactory::getNewFitnessCalculatorFor( std::shared_ptr< neat::NetworkPhenotype > net, size_t testNum, uint64_t generation, uint64_t individual ) const
+    {
+        // the noise of a run only depends on which run it is, not on how many draws the other threads made first
+        std::shared_ptr< Rand::RandomFunctor > perturb = nullptr;
+        if( random != nullptr && testNum != 0 )
+        {
+            perturb = std::make_shared<Rand::Random_Counter>( perturbSeed, generation, individual, testNum );
+        }
+
         std::shared_ptr< spkn::FitnessCalculator > calc;
-        calc = std::make_shared<spkn::FitnessCalculator>( net, rom_path, stepsPerFrame, colorRings, avtivationMaxValue, NESpixelsPerNetworkPixel, actionsPerMinute, ( random != nullptr && testNum != 0 ? std::make_shared<Rand::Random_Unsafe>( random->Int() ) : nullptr ) );
+        calc = std::make_shared<spkn::FitnessCalculator>( net, cartridge, getStartState( testNum ), stepsPerFrame, colorRings, avtivationMaxValue, NESpixelsPerNetworkPixel, actionsPerMinute, perturb );
 
         calc->setParentFactory( this );
 
@@ -412,7 +567,72 @@ namespace spkn
     size_t
     FitnessFactory::numTimesToTest() const
     {
-        return num_times_to_test;
+        // without a random number generator a second run from the same start state comes out the same
+        std::lock_guard< std::mutex > lock( levelStartStatesMutex );
+        const size_t numStartStates = 1 + std::min( numLevelStartRuns, levelStartStates.size() );
+        return random == nullptr ? std::min( num_times_to_test, numStartStates ) : num_times_to_test;
+    }
+
+    std::shared_ptr< const sn::SaveState >
+    FitnessFactory::getStartState( size_t testNum ) const
+    {
+        // the runs go around the start of the game, then the furthest levels reached, furthest first
+        std::lock_guard< std::mutex > lock( levelStartStatesMutex );
+        const size_t levelRuns = std::min( numLevelStartRuns, levelStartStates.size() );
+        const size_t startIndex = testNum % ( 1 + levelRuns );
+        if( startIndex == 0 )
+        {
+            return startState;
+        }
+
+        auto it = levelStartStates.rbegin();
+        std::advance( it, startIndex - 1 );
+        return it->second.state;
+    }
+
+    bool
+    FitnessFactory::isDeterministic() const
+    {
+        // the first test of every network never gets a random number generator
+        return random == nullptr || numTimesToTest() <= 1;
+    }
+
+    uint64_t
+    FitnessFactory::getConfigurationHash() const
+    {
+        // bump when the fitness function itself changes, so old cached scores are not reused
+        //   2: level start runs
+        //   3: the network activity terms count the input values as pulses again, as they did before the input port
+        //   4: loops are found on the game state alone, and skipped ones count their network activity
+        //   5: level start runs are among the num_times_to_test runs, and are scored relative to their start state
+        const uint64_t fitness_function_version = 5;
+
+        std::ostringstream ss;
+        ss << fitness_function_version << ' ';
+        {
+            // the cartridge's own hash comes from std::hash, which is not stable across standard libraries
+            neat::ContentHasher rom_hasher;
+            rom_hasher.add_bytes( cartridge->getROM().data(), cartridge->getROM().size() );
+            rom_hasher.add_bytes( cartridge->getVROM().data(), cartridge->getVROM().size() );
+            ss << rom_hasher.value() << ' ';
+        }
+        ss << stepsPerFrame << ' ' << colorRings << ' ' << NESpixelsPerNetworkPixel << ' ' << num_times_to_test << ' ';
+        ss << std::hexfloat << avtivationMaxValue << ' ' << actionsPerMinute << ' ';
+
+        // scores from different start states are different scores
+        ss << numLevelStartRuns;
+        {
+            std::lock_guard< std::mutex > lock( levelStartStatesMutex );
+            for( const auto& level : levelStartStates )
+            {
+                ss << ' ' << level.first << ':' << level.second.hash;
+            }
+        }
+
+        // the key is saved with the fitness cache, so it has to come out the same on every toolchain
+        neat::ContentHasher hasher;
+        hasher.add_string( ss.str() );
+        return hasher.value();
     }
 
     void
@@ -429,7 +649,38 @@ namespace spkn
     }
 
     void
-    FitnessFactory::regesterScreenData( std::shared_ptr<sf::Image> data )
+    FitnessFactory::addLevelStartState( uint16_t world_level, const sn::Emulator& emulator )
+    {
+        if( numLevelStartRuns == 0 )
+        {
+            return;
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( levelStartStatesMutex );
+            if( levelStartStates.count( world_level ) )
+            {
+                return;
+            }
+        }
+
+        auto state = std::make_shared< const sn::SaveState >( emulator.saveState() );
+        // part of the configuration hash, so hashed the same way
+        neat::ContentHasher hasher;
+        hasher.add_bytes( state->data.data(), state->data.size() );
+        uint64_t hash = hasher.value();
+
+        // which network gets somewhere first depends on thread timing, keeping the smallest hash does not
+        std::lock_guard< std::mutex > lock( levelStartStatesMutex );
+        auto it = newLevelStartStates.find( world_level );
+        if( it == newLevelStartStates.end() || hash < it->second.hash )
+        {
+            newLevelStartStates[ world_level ] = { hash, state };
+        }
+    }
+
+    void
+    FitnessFactory::regesterScreenData( std::shared_ptr<const sn::FrameBuffer> data )
     {
         if( preview_window )
         {
@@ -438,7 +689,7 @@ namespace spkn
     }
 
     void
-    FitnessFactory::unregesterScreenData( std::shared_ptr<sf::Image> data )
+    FitnessFactory::unregesterScreenData( std::shared_ptr<const sn::FrameBuffer> data )
     {
         if( preview_window )
         {
@@ -2,13 +2,15 @@
 #define SPKN_FITNESS_HPP_INCLUDED
 
 #include "../simple_nes/include/Emulator.h"
+#include "../simple_nes/include/CartridgeRegistry.h"
 #include "../spnn/spnn.hpp"
 
-#include "preview_window.hpp"
 #include "game_state.hpp"
+#include "loop_detector.hpp"
 
 namespace spkn
 {
+    class PreviewWindow;
     class FitnessFactory;
 
     class FitnessCalculator : public neat::FitnessCalculator
@@ -29,6 +31,16 @@ namespace spkn
             double lastKnownScreenPosition;
             uint64_t numVBlanksWithoutMoving;
 
+            StateLoopDetector stateLoops;
+            uint64_t loopSkippedVBlanks; // frames a proven loop would have run for before stopTest, counted but never emulated
+            long double loopSkippedPulses; // the network activity of those frames, at the rate of the loop
+
+            uint64_t startVBlanks;       // the start state's own vblanks, played by whoever reached it
+            uint64_t startScore;         // as is the score, level and lives it was reached with, a run is scored on what it adds
+            uint16_t startWorldLevel;
+            uint16_t startLives;
+            uint16_t currentWorldLevel;
+
             GameState_SuperMarioBros gameStateExtractor;
 
             std::shared_ptr<Rand::RandomFunctor> random;
@@ -46,6 +58,7 @@ namespace spkn
             // screen settings
 
             std::vector< double > screenInput;
+            std::vector< float > screenScratch;
             size_t spiralRings;
             double activationMaxValue;
             size_t NESpixelsPerNetworkPixel;
@@ -56,7 +69,7 @@ namespace spkn
 
         public:
 
-            FitnessCalculator( std::shared_ptr< neat::NetworkPhenotype > net, const std::string& rom_path, uint64_t stepsPerFrame, size_t colorRings, double maxActivationWeight, size_t downscaleRatio, double APM, std::shared_ptr<Rand::RandomFunctor> _rand = nullptr );
+            FitnessCalculator( std::shared_ptr< neat::NetworkPhenotype > net, std::shared_ptr< const sn::Cartridge > cartridge, std::shared_ptr< const sn::SaveState > startState, uint64_t stepsPerFrame, size_t colorRings, double maxActivationWeight, size_t downscaleRatio, double APM, std::shared_ptr<Rand::RandomFunctor> _rand = nullptr );
             virtual ~FitnessCalculator();
 
             FitnessCalculator( const FitnessCalculator& ) = delete;
@@ -66,7 +79,7 @@ namespace spkn
             size_t numOutputs();
 
             // emulator stuff
-            std::shared_ptr<sf::Image> getScreenData() const;
+            std::shared_ptr<const sn::FrameBuffer> getScreenData() const;
             uint64_t getNumVBlank() const;
 
         protected:
@@ -86,8 +99,15 @@ namespace spkn
             // controller stuff
 
             void resetControllerState();
+            sn::Byte getControllerButtons() const;
             void activateButton( size_t button );
 
+            // loop stuff
+
+            uint64_t getLoopStateHash( sn::Byte buttons ) const;
+            uint64_t getNetworkPulses() const;
+            void skipRepeatingLoop();
+
             // book-keeping stuff
 
             void setParentFactory( const FitnessFactory * factory );
@@ -101,12 +121,28 @@ namespace spkn
         private:
 
             std::string rom_path;
+            std::shared_ptr< const sn::Cartridge > cartridge;   // shared with every emulator through the registry
+            std::shared_ptr< const sn::SaveState > startState;  // the game booted to the first controllable frame
             uint64_t stepsPerFrame;
             size_t colorRings;
 
             std::shared_ptr<Rand::RandomFunctor> random;
+            uint64_t perturbSeed; // the input noise of each run is drawn from the stream for its generation, individual and test number under this seed
             size_t num_times_to_test;
 
+            // the first state seen of each level, the runs of a network are spread over the start of the game and the furthest levels in here
+            //   new levels are only added between generations, so a whole generation is tested from the same states
+            struct LevelStartState
+            {
+                uint64_t hash;
+                std::shared_ptr< const sn::SaveState > state;
+            };
+
+            size_t numLevelStartRuns;
+            mutable std::mutex levelStartStatesMutex;
+            std::map< uint16_t, LevelStartState > levelStartStates;
+            std::map< uint16_t, LevelStartState > newLevelStartStates;
+
             std::atomic<uint64_t> totalVBlanks;
             std::atomic<uint64_t> individualsProcessed;
             std::atomic<uint64_t> generationsProcessed;
@@ -121,7 +157,7 @@ namespace spkn
 
         public:
 
-            FitnessFactory( const std::string& mario_rom, std::shared_ptr<PreviewWindow> window, double maxWeightForActivation, double APM, std::shared_ptr<Rand::RandomFunctor> _rand = nullptr, size_t runs_to_average = 1, uint64_t steps_per_frame = 100, size_t color_rings = 5, size_t downscaleRatio = 2 );
+            FitnessFactory( const std::string& mario_rom, std::shared_ptr<PreviewWindow> window, double maxWeightForActivation, double APM, std::shared_ptr<Rand::RandomFunctor> _rand = nullptr, size_t runs_to_average = 1, uint64_t steps_per_frame = 100, size_t color_rings = 5, size_t downscaleRatio = 2, size_t level_start_runs = 0 );
             virtual ~FitnessFactory();
 
             uint64_t getTotalVBlanks() const;
@@ -131,16 +167,24 @@ namespace spkn
 
             void incrementGeneration();
 
+            size_t numLevelStartStates() const;
+
         protected:
 
             std::shared_ptr< neat::FitnessCalculator > getNewFitnessCalculator( std::shared_ptr< neat::NetworkPhenotype > net, size_t testNum ) const override;
+            std::shared_ptr< neat::FitnessCalculator > getNewFitnessCalculatorFor( std::shared_ptr< neat::NetworkPhenotype > net, size_t testNum, uint64_t generation, uint64_t individual ) const override;
             size_t numTimesToTest() const override;
 
+            bool isDeterministic() const override;
+            uint64_t getConfigurationHash() const override;
+
             // book-keeping stuff
 
             void addToTotalVBlanks( uint64_t num_vblanks );
-            void regesterScreenData( std::shared_ptr<sf::Image> data );
-            void unregesterScreenData( std::shared_ptr<sf::Image> data );
+            void addLevelStartState( uint16_t world_level, const sn::Emulator& emulator );
+            std::shared_ptr< const sn::SaveState > getStartState( size_t testNum ) const;
+            void regesterScreenData( std::shared_ptr<const sn::FrameBuffer> data );
+            void unregesterScreenData( std::shared_ptr<const sn::FrameBuffer> data );
 
             // friends
             friend class FitnessCalculator;
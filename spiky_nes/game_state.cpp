@@ -2,8 +2,28 @@
 
 #include "game_state.hpp"
 
+#include "../spnn/neat/content_hasher.hpp"
+
 namespace spkn
 {
+    namespace
+    {
+        // work ram left out of GameState_SuperMarioBros::LoopStateHash, inclusive ranges in address order
+        const std::pair< sn::Address, sn::Address > loopStateIgnoredRAM[] =
+        {
+            { 0x0009, 0x0009 }, // frame counter
+            { 0x00F0, 0x00FF }, // sound engine
+            { 0x077F, 0x077F }, // interval timer control
+            { 0x0787, 0x0787 }, // frames to the next level timer tick
+            { 0x07A7, 0x07AD }, // pseudo random bits
+            { 0x07B0, 0x07CA }, // sound engine
+            { 0x07F8, 0x07FA }, // level timer
+        };
+
+        const sn::Address workRAMSize = 0x0800;
+        const uint64_t framesPerTimerTick = 24;
+    }
+
     uint64_t
     getBCDValue( sn::Address begin, sn::Address end, const sn::Emulator& emulator, bool inclusive )
     {
@@ -33,14 +53,20 @@ namespace spkn
         // and should step the emulator to the first point in which the player
         // can actually control the character
 
+        // nobody looks at the screen until the game is running, so only draw the frames
+        // that could be the last one, the network sees that one first
+        emulator.setRenderMode( sn::SkipPixels );
+
         emulator.stepNFrames(30); // initial load
         // press start
-        emulator.setControllerCallbackMap( { { sn::Controller::Start, []{ return true; } }, }, {} );
+        emulator.setControllerState( 0, 1 << sn::Controller::Start );
         emulator.stepNFrames(1); // for one frame
-        emulator.setControllerCallbacks( {}, {} ); // release start
+        emulator.setControllerState( 0, 0 ); // release start
 
         // step until game init is done and passed the X lives left screen
-        emulator.stepNFrames(7);
+        emulator.stepNFrames(6);
+        emulator.setRenderMode( sn::DrawPixels );
+        emulator.stepNFrames(1);
         while( emulator.peakMemory(0x07A0) > 1 )
         {
             emulator.stepNFrames(1);
@@ -135,4 +161,33 @@ namespace spkn
         return emulator.peakMemory( 0x075E );
     }
 
+
+    uint64_t
+    GameState_SuperMarioBros::LoopStateHash() const
+    {
+        neat::ContentHasher hasher;
+
+        sn::Address address = 0x0000;
+        for( const auto& ignored : loopStateIgnoredRAM )
+        {
+            for( ; address < ignored.first; ++address )
+            {
+                hasher.add( emulator.peakMemory( address ) );
+            }
+            address = ignored.second + 1;
+        }
+        for( ; address < workRAMSize; ++address )
+        {
+            hasher.add( emulator.peakMemory( address ) );
+        }
+
+        return hasher.value();
+    }
+
+    uint64_t
+    GameState_SuperMarioBros::FramesUntilTimeUp() const
+    {
+        return Time() * framesPerTimerTick;
+    }
+
 }
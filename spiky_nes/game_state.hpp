@@ -37,6 +37,11 @@ namespace spkn
 
             uint16_t Coins_BCD() const;
             uint8_t  Coins_Byte() const;
+
+            // hash of the work ram, without what counts along every frame whatever the player does, so standing still repeats
+            uint64_t LoopStateHash() const;
+            // at least this many frames until the level timer runs out, it counts down once every 24 frames
+            uint64_t FramesUntilTimeUp() const;
     };
 
 
@@ -0,0 +1,283 @@
+#include <algorithm>
+#include <cmath>
+
+#include "loop_detector.hpp"
+
+namespace spkn
+{
+    StateLoopDetector::StateLoopDetector( uint64_t max_period )
+         : maxPeriod( std::max<uint64_t>( 1, max_period ) ),
+        history( maxPeriod + 1, 0 ),
+        totals( maxPeriod + 1, 0 ),
+        lastSeen(),
+        frame( 0 ),
+        period( 0 ),
+        framesRepeated( 0 )
+    {
+        /*  */
+    }
+
+    void
+    StateLoopDetector::reset()
+    {
+        lastSeen.clear();
+        frame = 0;
+        period = 0;
+        framesRepeated = 0;
+    }
+
+    bool
+    StateLoopDetector::addState( uint64_t state_hash, uint64_t running_total )
+    {
+        const uint64_t slot = frame % history.size();
+
+        // the frame about to be overwritten falls out of reach of any period
+        if( frame >= history.size() )
+        {
+            auto it = lastSeen.find( history[ slot ] );
+            if( it != lastSeen.end() && it->second == frame - history.size() )
+            {
+                lastSeen.erase( it );
+            }
+        }
+
+        if( period > 0 && history[ ( frame - period ) % history.size() ] == state_hash )
+        {
+            ++framesRepeated;
+        }
+        else
+        {
+            // start over with the most recent time this state was seen, the shortest candidate period
+            auto it = lastSeen.find( state_hash );
+            period = ( it != lastSeen.end() ) ? frame - it->second : 0;
+            framesRepeated = ( period > 0 ) ? 1 : 0;
+        }
+
+        history[ slot ] = state_hash;
+        totals[ slot ] = running_total;
+        lastSeen[ state_hash ] = frame;
+        ++frame;
+
+        return period > 0 && framesRepeated >= period;
+    }
+
+    uint64_t
+    StateLoopDetector::Period() const
+    {
+        return period;
+    }
+
+    uint64_t
+    StateLoopDetector::TotalOverPeriod() const
+    {
+        if( period == 0 || frame <= period )
+        {
+            return 0;
+        }
+
+        return totals[ ( frame - 1 ) % totals.size() ] - totals[ ( frame - 1 - period ) % totals.size() ];
+    }
+
+    uint64_t
+    SkipLoopToIdleLimit( uint64_t period, uint64_t max_frames, std::initializer_list< IdleCounter > counters )
+    {
+        if( period == 0 )
+        {
+            return 0;
+        }
+
+        uint64_t framesLeft = ~uint64_t( 0 );
+        for( const IdleCounter& counter : counters )
+        {
+            if( *counter.frames >= period )
+            {
+                framesLeft = std::min( framesLeft, counter.limit - std::min( counter.limit, *counter.frames ) );
+            }
+        }
+
+        // something in the loop keeps resetting all of them, or something outside of the loop ends the run first
+        if( framesLeft >= max_frames )
+        {
+            return 0;
+        }
+
+        for( const IdleCounter& counter : counters )
+        {
+            if( *counter.frames >= period )
+            {
+                *counter.frames += framesLeft;
+            }
+        }
+
+        return framesLeft;
+    }
+
+    bool
+    TestStateLoopDetector( std::ostream& out )
+    {
+        size_t numTests = 0;
+        size_t numFailures = 0;
+
+        auto check = [&]( bool passed, const char * what )
+        {
+            ++numTests;
+            if( !passed )
+            {
+                out << "loop detector: " << what << "\n";
+                ++numFailures;
+            }
+        };
+
+        const uint64_t maxPeriod = 600;
+
+        // a lead in of distinct states, then a cycle, is proven once the whole period has come around again
+        for( uint64_t period : { 1, 2, 3, 7, 24, 599, 600 } )
+        {
+            for( uint64_t leadIn : { 0, 1, 5, 1000 } )
+            {
+                StateLoopDetector detector( maxPeriod );
+
+                uint64_t total = 0;
+                uint64_t firstProven = 0;
+                bool proven = false;
+
+                for( uint64_t frame = 0; frame < leadIn + 3 * period && !proven; ++frame )
+                {
+                    const uint64_t phase = ( frame - leadIn ) % period;
+                    total += frame < leadIn ? 3 : phase * 5 + 1;
+
+                    proven = detector.addState( frame < leadIn ? frame : ( 1ULL << 32 ) + phase, total );
+                    firstProven = frame;
+                }
+
+                check( proven && firstProven == leadIn + 2 * period - 1, "a cycle is not proven as soon as one period repeats" );
+                check( proven && detector.Period() == period, "the period is wrong" );
+                check( proven && detector.TotalOverPeriod() == ( period * ( period - 1 ) / 2 ) * 5 + period, "the running total over a period is wrong" );
+            }
+        }
+
+        // no repeats, cycles longer than the limit, and cycles that break, are never proven
+        {
+            StateLoopDetector distinct( maxPeriod ), tooLong( maxPeriod ), broken( maxPeriod );
+
+            bool proven = false;
+            for( uint64_t frame = 0; frame < 10 * maxPeriod; ++frame )
+            {
+                proven |= distinct.addState( frame );
+                proven |= tooLong.addState( frame % ( maxPeriod + 1 ) );
+                // every other time around one state is new
+                proven |= broken.addState( ( frame / 50 ) % 2 == 1 && frame % 50 == 49 ? ~frame : frame % 50 );
+            }
+            check( !proven, "a loop is proven that does not repeat within the limit" );
+        }
+
+        // reset forgets everything seen
+        {
+            StateLoopDetector detector( maxPeriod );
+
+            for( uint64_t frame = 0; frame < 10; ++frame )
+            {
+                detector.addState( frame % 5 );
+            }
+            detector.reset();
+
+            bool proven = false;
+            for( uint64_t frame = 0; frame < 9; ++frame )
+            {
+                proven |= detector.addState( frame % 5 );
+            }
+            check( !proven && detector.addState( 4 ), "reset does not start the proof over" );
+        }
+
+        // a run played to the end against the same run skipped from the moment its loop is proven. the runs press buttons and move
+        // during the lead in, then loop, the loop may keep resetting either counter. the network activity is extrapolated from
+        // one period, so it may differ from the full run by less than one period's worth
+        struct ToyRun
+        {
+            uint64_t frames;
+            long double pulses;
+            bool timedOut;
+            uint64_t skipped;
+        };
+
+        auto playToy = [&]( uint64_t leadIn, uint64_t period, bool pressInLoop, bool moveInLoop, uint64_t timeUp, bool skip ) -> ToyRun
+        {
+            const uint64_t maxWithoutPress = 900;
+            const uint64_t maxWithoutMoving = 1800;
+
+            StateLoopDetector detector( maxPeriod );
+
+            ToyRun run = { 0, 0.0L, false, 0 };
+            uint64_t pulses = 0;
+            uint64_t withoutPress = 0;
+            uint64_t withoutMoving = 0;
+
+            while( withoutPress < maxWithoutPress && withoutMoving < maxWithoutMoving )
+            {
+                if( run.frames >= timeUp )
+                {
+                    run.timedOut = true;
+                    break;
+                }
+
+                const uint64_t frame = run.frames++;
+                const uint64_t phase = ( frame - leadIn ) % period;
+                const bool inLoop = frame >= leadIn;
+
+                pulses += inLoop ? phase * 5 + 1 : 3;
+                withoutPress = ( inLoop ? pressInLoop && phase == 0 : frame % 40 == 0 ) ? 0 : withoutPress + 1;
+                withoutMoving = ( inLoop ? moveInLoop && phase == period / 2 : frame % 10 == 0 ) ? 0 : withoutMoving + 1;
+
+                if( skip && detector.addState( inLoop ? ( 1ULL << 32 ) + phase : frame, pulses ) )
+                {
+                    uint64_t skipped = SkipLoopToIdleLimit( detector.Period(), timeUp - run.frames, { { &withoutPress, maxWithoutPress }, { &withoutMoving, maxWithoutMoving } } );
+
+                    run.frames += skipped;
+                    run.skipped += skipped;
+                    run.pulses += (long double)( detector.TotalOverPeriod() ) * (long double)( skipped ) / (long double)( detector.Period() );
+                }
+            }
+
+            run.pulses += (long double)( pulses );
+
+            return run;
+        };
+
+        struct ToyCase
+        {
+            uint64_t leadIn;
+            uint64_t period;
+            bool pressInLoop;
+            bool moveInLoop;
+            uint64_t timeUp;
+            bool skips;
+            const char * what;
+        };
+
+        const std::vector< ToyCase > toyCases =
+        {
+            {  50,   7, false,  true, 100000,  true, "a loop without presses is not skipped to the end" },
+            {  50,   1, false, false, 100000,  true, "standing still is not skipped to the end" },
+            { 123, 300,  true, false, 100000,  true, "a loop without movement is not skipped to the end" },
+            { 500,  24,  true,  true,   5000, false, "a loop that resets both counters is skipped" },
+            {  50,   7, false,  true,    700, false, "a loop that times out before its limit is skipped" },
+            {  50, 650, false,  true, 100000, false, "a loop longer than the limit is skipped" },
+        };
+
+        for( const ToyCase& toy : toyCases )
+        {
+            ToyRun full = playToy( toy.leadIn, toy.period, toy.pressInLoop, toy.moveInLoop, toy.timeUp, false );
+            ToyRun skipped = playToy( toy.leadIn, toy.period, toy.pressInLoop, toy.moveInLoop, toy.timeUp, true );
+
+            const long double perPeriod = (long double)( ( toy.period * ( toy.period - 1 ) / 2 ) * 5 + toy.period );
+
+            check( ( skipped.skipped > 0 ) == toy.skips, toy.what );
+            check( skipped.frames == full.frames && skipped.timedOut == full.timedOut, "a skipped run does not end on the frame the full run does" );
+            check( std::fabs( skipped.pulses - full.pulses ) < perPeriod, "a skipped run's network activity is off by more than a period" );
+        }
+
+        out << ( numFailures ? "FAILED" : "passed" ) << ": " << numTests << " loop detector checks, " << numFailures << " failed\n";
+
+        return numFailures == 0;
+    }
+}
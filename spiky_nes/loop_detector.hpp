@@ -0,0 +1,60 @@
+#ifndef SPKN_LOOP_DETECTOR_HPP_INCLUDED
+#define SPKN_LOOP_DETECTOR_HPP_INCLUDED
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <initializer_list>
+#include <ostream>
+
+namespace spkn
+{
+    // watches one state hash per frame for the states to start going around in a cycle,
+    // a cycle counts as proven once a whole period of it has repeated exactly
+    class StateLoopDetector
+    {
+        private:
+
+            uint64_t maxPeriod;
+
+            std::vector< uint64_t > history;                 // ring buffer of the last maxPeriod + 1 hashes
+            std::vector< uint64_t > totals;                  // the running total given with each hash in history
+            std::unordered_map< uint64_t, uint64_t > lastSeen; // hash to the last frame it was seen on, within the history
+
+            uint64_t frame;
+            uint64_t period;
+            uint64_t framesRepeated;
+
+        public:
+
+            StateLoopDetector( uint64_t max_period );
+
+            void reset();
+
+            // returns true once the hashes of the last Period() frames are the same as the Period() frames before them
+            //   running_total is anything that only adds up frame to frame, see TotalOverPeriod
+            bool addState( uint64_t state_hash, uint64_t running_total = 0 );
+
+            uint64_t Period() const;
+
+            // what the running total grew by over the last Period() frames, what the loop adds every time around
+            uint64_t TotalOverPeriod() const;
+    };
+
+    // a count of frames since something last happened, that stops the run once it reaches its limit
+    struct IdleCounter
+    {
+        uint64_t * frames;
+        uint64_t limit;
+    };
+
+    // once a loop of the given period is proven, a counter that went a whole period without being reset is never reset again,
+    // so it reaches its limit after a known number of frames. advances the counters to the first of those limits and returns
+    // the frames skipped, or 0 if the loop resets every counter, or if the skip would be max_frames or more
+    uint64_t SkipLoopToIdleLimit( uint64_t period, uint64_t max_frames, std::initializer_list< IdleCounter > counters );
+
+    // checks StateLoopDetector and SkipLoopToIdleLimit against runs that are played out in full
+    bool TestStateLoopDetector( std::ostream& out );
+}
+
+#endif // SPKN_LOOP_DETECTOR_HPP_INCLUDED
@@ -240,7 +240,9 @@ main( int argc, char** argv )
     if( fitnessFactory == nullptr )
     {
         bool is_deterministic = settings->var.get<bool>( "fitness_deterministic", true );
-        size_t num_runs = is_deterministic ? 1 : settings->var.get<size_t>( "fitness_runs", 1 );
+        size_t num_start_levels = settings->var.get<size_t>( "fitness_start_levels", 0 );
+        // a deterministic run only needs to be run once from each start state
+        size_t num_runs = is_deterministic ? 1 + num_start_levels : settings->var.get<size_t>( "fitness_runs", 1 );
 
         fitnessFactory = std::make_shared< spkn::FitnessFactory >(
             settings->arg_rom_path,
@@ -251,7 +253,8 @@ main( int argc, char** argv )
             num_runs, // number of times the network is tested
             100, // network steps per NES frame
             5, // color winding value
-            settings->var.get<size_t>( "fitness_downscale_ratio", 16 ) // ratio of NES pixels (squared) to network inputs, powers of 2 are a best bet here
+            settings->var.get<size_t>( "fitness_downscale_ratio", 16 ), // ratio of NES pixels (squared) to network inputs, powers of 2 are a best bet here
+            num_start_levels // number of the furthest levels reached so far that the runs are spread over, along with the start of the game
         );
     }
 
@@ -410,6 +413,56 @@ main( int argc, char** argv )
         std::cout << "Done." << std::endl;
     }
 
+    // reuse the scores of genotypes that come through a generation unchanged, only works when the fitness factory is deterministic
+    std::shared_ptr< neat::FitnessCache > fitnessCache = nullptr;
+    const std::string fitness_cache_path = settings->var.get<std::string>( "fitness_cache_file", "" );
+
+    if( settings->var.get<bool>( "fitness_cache", true ) )
+    {
+        std::string cache_data = fitness_cache_path.empty() ? std::string() : spkn::GetFileAsString( fitness_cache_path );
+
+        if( !cache_data.empty() )
+        {
+            std::cout << "Loading Fitness Cache From File '" << fitness_cache_path << "' ... " << std::flush;
+
+            try
+            {
+                rapidxml::xml_document<> doc;
+                doc.parse<rapidxml::parse_default>( &cache_data[0] );
+
+                fitnessCache = std::make_shared< neat::FitnessCache >( neat::xml::FindNode( "fitness_cache", &doc ) );
+
+                std::cout << "Done. (" << fitnessCache->size() << " entries)" << std::endl;
+            }
+            catch( const rapidxml::parse_error& e )
+            {
+                std::cout << "Failed. " << e.what() << std::endl;
+            }
+        }
+
+        if( fitnessCache == nullptr )
+        {
+            fitnessCache = std::make_shared< neat::FitnessCache >();
+        }
+
+        population->setFitnessCache( fitnessCache );
+    }
+
+    auto save_fitness_cache = [fitnessCache,fitness_cache_path]() -> void
+    {
+        if( fitnessCache == nullptr || fitness_cache_path.empty() )
+        {
+            return;
+        }
+
+        rapidxml::xml_document<> doc;
+        fitnessCache->SaveToXML( &doc, &doc );
+
+        std::ofstream cache_file( fitness_cache_path, std::ofstream::trunc );
+        cache_file << doc << std::flush;
+        cache_file.close();
+    };
+
     std::cout << "Population First Mutation ... " << std::flush;
 
     if( false )
@@ -526,6 +579,7 @@ main( int argc, char** argv )
     }
 
     AtExit( onExit_close );
+    AtExit( save_fitness_cache );
 
     double base_attrition  = settings->var.get<double>( "attr_base", 0.5 );
     double attrition_range = settings->var.get<double>( "attr_range", 0.0125 );
@@ -671,6 +725,7 @@ main( int argc, char** argv )
         // this is the only line in this loop that really matters *******************************************************
         population->IterateGeneration( thread_pool, random, attritionRate, gen_dbg_callbacks );
         fitnessFactory->incrementGeneration();
+        save_fitness_cache();
 
         double genComplettionTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - generation_start_time).count();
         std::cout << "\tDone. (~" << round(1000.0*genComplettionTime)/1000.0 << "s " << spkn::SecondsToHMS( genComplettionTime ) << ")\n\n" << std::flush;
@@ -684,6 +739,11 @@ main( int argc, char** argv )
 
         std::cout << "\tattrRate = " << attritionRate << "\n";
 
+        if( fitnessCache != nullptr )
+        {
+            std::cout << "\tfitnessCache = " << fitnessCache->size() << " entries, " << fitnessCache->getNumHits() << " hits, " << fitnessCache->getNumMisses() << " misses\n";
+        }
+
         auto genData = population->getLastGenerationData();
 
         if( !genData )
@@ -31,8 +31,7 @@ namespace spkn
         numIndividualsProcessed( 0 ),
         numGenerationsProcessed( 0 )
     {
-        blankScreenData = std::make_shared<sf::Image>();
-        blankScreenData->create( sn::NESVideoWidth, sn::NESVideoHeight, sf::Color{ 127,127,127,255 } );
+        blankScreenData = std::make_shared<sn::FrameBuffer>( 0x00 ); // grey
 
         /*size_t width_inNES = num_columns;
         size_t height_inNES = num_previews / num_columns + ( num_previews % num_columns ? 1 : 0 );*/
@@ -40,7 +39,7 @@ namespace spkn
         while( virtual_screens.size() < num_previews )
         {
             virtual_screens.push_back( sn::VirtualScreen{} );
-            virtual_screens.back().create( sn::NESVideoWidth, sn::NESVideoHeight, pixelSize, sf::Color::Blue );
+            virtual_screens.back().create( sn::NESVideoWidth, sn::NESVideoHeight, pixelSize );
             virtual_screens.back().setScreenData( blankScreenData );
 
             size_t i = virtual_screens.size() - 1;
@@ -61,13 +60,13 @@ namespace spkn
     }
 
     void
-    PreviewWindow::addScreenData( std::shared_ptr<sf::Image> data )
+    PreviewWindow::addScreenData( std::shared_ptr<const sn::FrameBuffer> data )
     {
         screen_data_queue_in.push( data );
     }
 
     void
-    PreviewWindow::removeScreenData( std::shared_ptr<sf::Image> data )
+    PreviewWindow::removeScreenData( std::shared_ptr<const sn::FrameBuffer> data )
     {
         screen_data_queue_out.push( data );
     }
@@ -334,7 +333,7 @@ namespace spkn
 
         for( auto& vs : virtual_screens )
         {
-            std::shared_ptr<sf::Image> target( nullptr );
+            std::shared_ptr<const sn::FrameBuffer> target( nullptr );
             if( vs.getScreenData() == blankScreenData && screen_data_queue_in.try_pop( target ) && target != nullptr )
             {
                 vs.setScreenData( target );
@@ -363,14 +362,14 @@ namespace spkn
             screen_data_to_remove.clear();
         }
 
-        std::shared_ptr<sf::Image> target( nullptr );
+        std::shared_ptr<const sn::FrameBuffer> target( nullptr );
         while( screen_data_queue_out.try_pop( target ) && target != nullptr )
         {
             screen_data_to_remove.push_back( target );
             target = nullptr;
         }
 
-        std::list< std::list< std::shared_ptr<sf::Image> >::iterator > wasRemovedIts;
+        std::list< std::list< std::shared_ptr<const sn::FrameBuffer> >::iterator > wasRemovedIts;
 
         for( auto it = screen_data_to_remove.begin(); it != screen_data_to_remove.end(); ++it )
         {
@@ -33,10 +33,10 @@ namespace spkn
             std::atomic_bool doRun;
             std::mutex virtual_screens_mutex;
             std::vector< sn::VirtualScreen > virtual_screens;
-            tpl::safe_queue< std::shared_ptr<sf::Image> > screen_data_queue_in;
-            tpl::safe_queue< std::shared_ptr<sf::Image> > screen_data_queue_out;
-            std::list< std::shared_ptr<sf::Image> > screen_data_to_remove;
-            std::shared_ptr<sf::Image> blankScreenData;
+            tpl::safe_queue< std::shared_ptr<const sn::FrameBuffer> > screen_data_queue_in;
+            tpl::safe_queue< std::shared_ptr<const sn::FrameBuffer> > screen_data_queue_out;
+            std::list< std::shared_ptr<const sn::FrameBuffer> > screen_data_to_remove;
+            std::shared_ptr<const sn::FrameBuffer> blankScreenData;
             std::thread window_thread;
 
             tpl::pool& working_thread_pool;
@@ -50,8 +50,8 @@ namespace spkn
             PreviewWindow( const std::string& window_name, size_t population_size, size_t num_previews, size_t num_columns, tpl::pool& thread_pool_to_limit, float screen_size_ratio = 2.0f );
             ~PreviewWindow();
 
-            void addScreenData( std::shared_ptr<sf::Image> data );
-            void removeScreenData( std::shared_ptr<sf::Image> data );
+            void addScreenData( std::shared_ptr<const sn::FrameBuffer> data );
+            void removeScreenData( std::shared_ptr<const sn::FrameBuffer> data );
 
             void close();
 
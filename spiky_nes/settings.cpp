@@ -1,8 +1,14 @@
+#include <chrono>
+
 #include "settings.hpp"
 
 #include "cmd.hpp"
 
 #include "helpers.hpp"
+#include "color.hpp"
+#include "loop_detector.hpp"
+
+#include "../simple_nes/include/Emulator.h"
 
 namespace spkn
 {
@@ -51,6 +57,9 @@ namespace spkn
             std::cout << "\t-n              num_generations\n\n";
             std::cout << "\t--rom           rom_path\n";
             std::cout << "\t--hash-rom      rom_path_to_hash\n";
+            std::cout << "\t--test-color    num_frames_to_test\n";
+            std::cout << "\t--test-loops    test the loop detection\n";
+            std::cout << "\t--bench-rom     rom_path_to_benchmark\n";
             std::cout << "\t--file-sync     save file on main thread\n";
             std::cout << "\t--file-async    save file on worker thread\n";
             std::cout << "\t--headless      disable preview window\n";
@@ -65,6 +74,68 @@ namespace spkn
             exit( 0 );
         };
 
+        auto color_test_func = [&]( size_t num_frames ) -> void
+        {
+            exit( spkn::TestFrameSobelEdgeDetectionToLightness( num_frames, std::cout ) ? 0 : 1 );
+        };
+
+        auto loop_test_func = [&]() -> void
+        {
+            exit( spkn::TestStateLoopDetector( std::cout ) ? 0 : 1 );
+        };
+
+        auto rom_bench_func = [&]( const std::string& rom_to_bench_path ) -> void
+        {
+            // headless emulation speed, the number every fitness test is bound by
+            const uint64_t num_frames = 3600;
+
+            for( auto mode : { sn::DrawPixels, sn::SkipPixels } )
+            {
+                sn::Emulator emulator;
+                if( !emulator.init( rom_to_bench_path ) )
+                {
+                    std::cout << "Could not load rom " << rom_to_bench_path << std::endl;
+                    exit( 1 );
+                }
+                emulator.setRenderMode( mode );
+
+                auto start = std::chrono::steady_clock::now();
+                emulator.stepNFrames( num_frames );
+                std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+
+                std::cout << ( mode == sn::DrawPixels ? "drawn:   " : "skipped: " );
+                std::cout << num_frames << " frames in " << elapsed.count() << "s, " << double( num_frames ) / elapsed.count() << " fps" << std::endl;
+            }
+
+            // forking cost, from a state part way into the game like a lookahead would
+            {
+                const uint64_t num_forks = 100000;
+
+                sn::Emulator emulator;
+                emulator.init( rom_to_bench_path );
+                emulator.setRenderMode( sn::SkipPixels );
+                emulator.stepNFrames( 600 );
+
+                sn::Emulator target;
+                auto start = std::chrono::steady_clock::now();
+                for( uint64_t i = 0; i < num_forks; ++i )
+                {
+                    emulator.forkInto( target );
+                }
+                std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+                std::cout << "forkInto: " << num_forks << " forks in " << elapsed.count() << "s, " << double( num_forks ) / elapsed.count() << " forks/s" << std::endl;
+
+                start = std::chrono::steady_clock::now();
+                for( uint64_t i = 0; i < num_forks / 10; ++i )
+                {
+                    emulator.fork();
+                }
+                elapsed = std::chrono::steady_clock::now() - start;
+                std::cout << "fork:     " << num_forks / 10 << " forks in " << elapsed.count() << "s, " << double( num_forks / 10 ) / elapsed.count() << " forks/s" << std::endl;
+            }
+            exit( 0 );
+        };
+
         auto assign_var = [&]( const std::string& var_data_str ) -> void
         {
             const std::string delim_str = "=";
@@ -124,6 +195,9 @@ namespace spkn
         cmd.add_void(          { "-v", "version" },                  version_func,                                                                                      "Prints version"  );
 
         cmd.add<std::string>(  { "--hash-rom", "hash_rom" },         rom_hash_func,                                                                                     "Path to rom file to hash"  );
+        cmd.add<size_t>(       { "--test-color", "test_color" },     color_test_func,                                                                                   "Number of frames to test the frame preprocessing on"  );
+        cmd.add_void(          { "--test-loops", "test_loops" },     loop_test_func,                                                                                    "Test the loop detection of the fitness runs"  );
+        cmd.add<std::string>(  { "--bench-rom", "bench_rom" },       rom_bench_func,                                                                                    "Path to rom file to benchmark emulation speed on"  );
 
         cmd.add<std::string>(  { "--set", "_var" },                  assign_var,                                                                                        "Set misc variables"  );
 
@@ -18,6 +18,7 @@ namespace spkn
 #include "fitness.hpp"
 #include "game_state.hpp"
 #include "helpers.hpp"
+#include "loop_detector.hpp"
 #include "preview_window.hpp"
 #include "settings.hpp"
 
@@ -23,6 +23,11 @@ int main()
         _tests::Test5();
         _tests::Test6();*/
         _tests::Test7();
+        //_tests::Test8();
+        //_tests::Test9();
+        //_tests::Test10();
+        //_tests::Test11();
+        //_tests::Test12();
     }
 
     return 0;
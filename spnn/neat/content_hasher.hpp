@@ -0,0 +1,51 @@
+#ifndef NEAT_CONTENT_HASHER_HPP_INCLUDED
+#define NEAT_CONTENT_HASHER_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace neat
+{
+    // FNV-1a, so persisted hashes do not depend on the standard library implementation
+    class ContentHasher
+    {
+        private:
+
+            uint64_t hash;
+
+        public:
+
+            ContentHasher() : hash( 0xcbf29ce484222325ULL ) {  }
+
+            template < typename T >
+            void add( const T& value )
+            {
+                static_assert( std::is_trivially_copyable< T >::value, "ContentHasher can only hash trivially copyable values" );
+
+                unsigned char bytes[ sizeof( T ) ];
+                std::memcpy( bytes, &value, sizeof( T ) );
+
+                add_bytes( bytes, sizeof( T ) );
+            }
+
+            void add_bytes( const void * data, size_t size )
+            {
+                const unsigned char * bytes = static_cast< const unsigned char * >( data );
+
+                for( size_t i = 0; i < size; ++i )
+                {
+                    hash ^= bytes[ i ];
+                    hash *= 0x100000001b3ULL;
+                }
+            }
+
+            void add_string( const std::string& str ) { add_bytes( str.data(), str.size() ); }
+
+            uint64_t value() const { return hash; }
+    };
+}
+
+#endif // NEAT_CONTENT_HASHER_HPP_INCLUDED
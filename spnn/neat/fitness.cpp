@@ -94,6 +94,140 @@ namespace neat
         network = nullptr;
     }
 
+    FitnessCache::FitnessCache( size_t max_entries )
+         : cacheMutex(), fitnessData(), insertionOrder(), maxEntries( std::max<size_t>( max_entries, 1 ) ), numHits( 0 ), numMisses( 0 )
+    {
+        /*  */
+    }
+
+    FitnessCache::FitnessCache( const rapidxml::xml_node<> * cache_node )
+         : FitnessCache()
+    {
+        assert( cache_node && neat::xml::Name( cache_node ) == "fitness_cache" );
+
+        auto node = const_cast< rapidxml::xml_node<> * >( cache_node );
+
+        xml::readSimpleValueNode( "max_entries", maxEntries, node );
+        maxEntries = std::max<size_t>( maxEntries, 1 );
+
+        std::vector< uint64_t > genotype_hashes;
+        std::vector< uint64_t > configuration_hashes;
+        std::vector< long double > fitnesses;
+
+        xml::readVectorData( "genotype_hashes", genotype_hashes, node );
+        xml::readVectorData( "configuration_hashes", configuration_hashes, node );
+        xml::readVectorData( "fitnesses", fitnesses, node );
+
+        assert( genotype_hashes.size() == configuration_hashes.size() && genotype_hashes.size() == fitnesses.size() );
+
+        // saved oldest first, so re-adding them keeps the eviction order
+        for( size_t i = 0; i < std::min( genotype_hashes.size(), std::min( configuration_hashes.size(), fitnesses.size() ) ); ++i )
+        {
+            addFitness( genotype_hashes[ i ], configuration_hashes[ i ], fitnesses[ i ] );
+        }
+    }
+
+    bool
+    FitnessCache::getFitness( uint64_t genotype_hash, uint64_t configuration_hash, long double& fitness ) const
+    {
+        std::lock_guard< std::mutex > lock( cacheMutex );
+
+        auto found = fitnessData.find( { genotype_hash, configuration_hash } );
+
+        if( found == fitnessData.end() )
+        {
+            ++numMisses;
+            return false;
+        }
+
+        ++numHits;
+        fitness = found->second;
+        return true;
+    }
+
+    void
+    FitnessCache::addFitness( uint64_t genotype_hash, uint64_t configuration_hash, long double fitness )
+    {
+        std::lock_guard< std::mutex > lock( cacheMutex );
+
+        auto inserted = fitnessData.emplace( key_type( genotype_hash, configuration_hash ), fitness );
+
+        if( !inserted.second )
+        {
+            inserted.first->second = fitness;
+            return;
+        }
+
+        insertionOrder.push_back( inserted.first->first );
+
+        while( fitnessData.size() > maxEntries )
+        {
+            fitnessData.erase( insertionOrder.front() );
+            insertionOrder.pop_front();
+        }
+    }
+
+    size_t
+    FitnessCache::size() const
+    {
+        std::lock_guard< std::mutex > lock( cacheMutex );
+        return fitnessData.size();
+    }
+
+    uint64_t
+    FitnessCache::getNumHits() const
+    {
+        return numHits;
+    }
+
+    uint64_t
+    FitnessCache::getNumMisses() const
+    {
+        return numMisses;
+    }
+
+    void
+    FitnessCache::clear()
+    {
+        std::lock_guard< std::mutex > lock( cacheMutex );
+
+        fitnessData.clear();
+        insertionOrder.clear();
+    }
+
+    void
+    FitnessCache::SaveToXML( rapidxml::xml_node<> * destination, rapidxml::memory_pool<> * mem_pool ) const
+    {
+        std::vector< uint64_t > genotype_hashes;
+        std::vector< uint64_t > configuration_hashes;
+        std::vector< long double > fitnesses;
+
+        {
+            std::lock_guard< std::mutex > lock( cacheMutex );
+
+            genotype_hashes.reserve( insertionOrder.size() );
+            configuration_hashes.reserve( insertionOrder.size() );
+            fitnesses.reserve( insertionOrder.size() );
+
+            for( const auto& key : insertionOrder )
+            {
+                genotype_hashes.push_back( key.first );
+                configuration_hashes.push_back( key.second );
+                fitnesses.push_back( fitnessData.at( key ) );
+            }
+        }
+
+        auto cache_node = xml::Node( "fitness_cache", "", mem_pool );
+
+        xml::appendSimpleValueNode( "max_entries", maxEntries, cache_node, mem_pool );
+
+        xml::appendVectorData( "genotype_hashes", genotype_hashes, cache_node, mem_pool );
+        xml::appendVectorData( "configuration_hashes", configuration_hashes, cache_node, mem_pool );
+        xml::appendVectorData( "fitnesses", fitnesses, cache_node, mem_pool );
+
+        destination->append_node( cache_node );
+    }
+
     NodeFitnessCallback::NodeFitnessCallback( FitnessCalculator * f, uint64_t outputNodeID )
          : outputNodeIDNum( outputNodeID ), fitness( f )
     {
@@ -120,7 +254,7 @@ namespace neat
         return *this;
     }
 
-    NodeFitnessCallback_Lambda::NodeFitnessCallback_Lambda( FitnessCalculator * f, NodeID outputNodeID, std::function< void( const spnn::neuron&, FitnessCalculator *, NodeID ) > func )
+    NodeFitnessCallback_Lambda::NodeFitnessCallback_Lambda( FitnessCalculator * f, NodeID outputNodeID, std::function< void( const spnn::compiled_neuron&, FitnessCalculator *, NodeID ) > func )
          : NodeFitnessCallback( f, outputNodeID ), lambdaFunction( func )
     {
         assert( f );
@@ -3,17 +3,23 @@
 
 #include <functional>
 #include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <atomic>
 
 namespace neat
 {
     class FitnessCalculator;
     class FitnessFactory;
+    class FitnessCache;
     class NodeFitnessCallback;
 }
 
 #include "network.hpp"
 #include "population.hpp"
 #include "neat.hpp"
+#include "xml.hpp"
 
 namespace neat
 {
@@ -66,7 +72,53 @@ namespace neat
             virtual ~FitnessFactory() = default;
 
             virtual std::shared_ptr< FitnessCalculator > getNewFitnessCalculator( std::shared_ptr< NetworkPhenotype > net, size_t testNum ) const = 0;
+            // the same, also given the generation and the index of the genotype in the population, so a factory that draws random values for its runs can give each run a stream of its own
+            virtual std::shared_ptr< FitnessCalculator > getNewFitnessCalculatorFor( std::shared_ptr< NetworkPhenotype > net, size_t testNum, uint64_t, uint64_t ) const { return getNewFitnessCalculator( net, testNum ); }
             virtual size_t numTimesToTest() const { return 1; }
+
+            // a deterministic factory always gives the same genotype the same score, so its scores can be cached
+            virtual bool isDeterministic() const { return false; }
+            // must change whenever anything that affects the score changes
+            virtual uint64_t getConfigurationHash() const { return 0; }
+    };
+
+    // fitness scores keyed by genotype content hash and fitness factory configuration hash
+    //   oldest entries are dropped first once maxEntries is reached
+    class FitnessCache
+    {
+        private:
+
+            typedef std::pair< uint64_t, uint64_t > key_type; // genotype, configuration
+
+            mutable std::mutex cacheMutex;
+
+            std::map< key_type, long double > fitnessData;
+            std::deque< key_type > insertionOrder;
+
+            size_t maxEntries;
+
+            mutable std::atomic< uint64_t > numHits;
+            mutable std::atomic< uint64_t > numMisses;
+
+        public:
+
+            FitnessCache( size_t max_entries = size_t( 1 ) << 20 );
+            FitnessCache( const rapidxml::xml_node<> * cache_node );
+            virtual ~FitnessCache() = default;
+
+            FitnessCache( const FitnessCache& ) = delete;
+            FitnessCache& operator=( const FitnessCache& ) = delete;
+
+            bool getFitness( uint64_t genotype_hash, uint64_t configuration_hash, long double& fitness ) const;
+            void addFitness( uint64_t genotype_hash, uint64_t configuration_hash, long double fitness );
+
+            size_t size() const;
+            uint64_t getNumHits() const;
+            uint64_t getNumMisses() const;
+
+            void clear();
+
+            void SaveToXML( rapidxml::xml_node<> * destination, rapidxml::memory_pool<> * mem_pool ) const;
     };
 
     class NodeFitnessCallback
@@ -82,7 +134,7 @@ namespace neat
             NodeFitnessCallback( const NodeFitnessCallback& other );
             virtual ~NodeFitnessCallback();
 
-            virtual void operator()( const spnn::neuron& n ) = 0;
+            virtual void operator()( const spnn::compiled_neuron& n ) = 0;
 
             NodeFitnessCallback& operator=( const NodeFitnessCallback& other );
 
@@ -96,15 +148,15 @@ namespace neat
     {
         protected:
 
-            std::function< void( const spnn::neuron&, FitnessCalculator *, NodeID ) > lambdaFunction;
+            std::function< void( const spnn::compiled_neuron&, FitnessCalculator *, NodeID ) > lambdaFunction;
 
         public:
 
-            NodeFitnessCallback_Lambda( FitnessCalculator * f, NodeID outputNodeID, std::function< void( const spnn::neuron&, FitnessCalculator *, NodeID ) > func );
+            NodeFitnessCallback_Lambda( FitnessCalculator * f, NodeID outputNodeID, std::function< void( const spnn::compiled_neuron&, FitnessCalculator *, NodeID ) > func );
             NodeFitnessCallback_Lambda( NodeFitnessCallback_Lambda& other );
             virtual ~NodeFitnessCallback_Lambda() = default;
 
-            inline void operator()( const spnn::neuron& n ) final;
+            inline void operator()( const spnn::compiled_neuron& n ) final;
     };
 }
 
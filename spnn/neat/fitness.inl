@@ -16,7 +16,7 @@ namespace neat
     }
 
     void
-    NodeFitnessCallback_Lambda::operator()( const spnn::neuron& n )
+    NodeFitnessCallback_Lambda::operator()( const spnn::compiled_neuron& n )
     {
         lambdaFunction( n, fitnessCalculatorData(), targetNodeID() );
     }
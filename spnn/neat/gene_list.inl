@@ -0,0 +1,311 @@
+#ifndef NEAT_GENE_LIST_INL_INCLUDED
+#define NEAT_GENE_LIST_INL_INCLUDED
+
+#include <atomic>
+#include <cassert>
+#include <tuple>
+#include <utility>
+
+namespace neat
+{
+    template< typename GeneType >
+    inline
+    GeneList< GeneType >::const_iterator::const_iterator()
+         : chunk( nullptr ), lastChunk( nullptr ), current( nullptr ), chunkEnd( nullptr )
+    {
+        /*  */
+    }
+
+    template< typename GeneType >
+    inline
+    GeneList< GeneType >::const_iterator::const_iterator( const std::shared_ptr< Chunk > * first, const std::shared_ptr< Chunk > * last )
+         : chunk( first ), lastChunk( last ), current( nullptr ), chunkEnd( nullptr )
+    {
+        std::tie( current, chunkEnd ) = findChunk( chunk, lastChunk );
+    }
+
+    template< typename GeneType >
+    inline
+    std::pair< const GeneType *, const GeneType * >
+    GeneList< GeneType >::const_iterator::findChunk( const std::shared_ptr< Chunk > * chunk, const std::shared_ptr< Chunk > * lastChunk )
+    {
+        if( chunk == lastChunk )
+        {
+            return { nullptr, nullptr };
+        }
+
+        const GeneType * first = (*chunk)->data();
+
+        return { first, first + (*chunk)->size() };
+    }
+
+    template< typename GeneType >
+    inline
+    typename GeneList< GeneType >::const_iterator::reference
+    GeneList< GeneType >::const_iterator::operator*() const
+    {
+        return *current;
+    }
+
+    template< typename GeneType >
+    inline
+    typename GeneList< GeneType >::const_iterator::pointer
+    GeneList< GeneType >::const_iterator::operator->() const
+    {
+        return current;
+    }
+
+    template< typename GeneType >
+    inline
+    typename GeneList< GeneType >::const_iterator&
+    GeneList< GeneType >::const_iterator::operator++()
+    {
+        ++current;
+
+        if( current == chunkEnd )
+        {
+            ++chunk;
+            std::tie( current, chunkEnd ) = findChunk( chunk, lastChunk );
+        }
+
+        return *this;
+    }
+
+    template< typename GeneType >
+    inline
+    typename GeneList< GeneType >::const_iterator
+    GeneList< GeneType >::const_iterator::operator++( int )
+    {
+        const_iterator out = *this;
+        ++(*this);
+        return out;
+    }
+
+    template< typename GeneType >
+    inline
+    bool
+    GeneList< GeneType >::const_iterator::operator==( const const_iterator& other ) const
+    {
+        return current == other.current;
+    }
+
+    template< typename GeneType >
+    inline
+    bool
+    GeneList< GeneType >::const_iterator::operator!=( const const_iterator& other ) const
+    {
+        return !( *this == other );
+    }
+
+    template< typename GeneType >
+    GeneList< GeneType >::GeneList()
+         : chunks(), numGenes( 0 )
+    {
+        /*  */
+    }
+
+    template< typename GeneType >
+    GeneList< GeneType >::GeneList( std::vector< GeneType > genes )
+         : chunks(), numGenes( genes.size() )
+    {
+        chunks.reserve( ( numGenes + ChunkSize - 1 ) / ChunkSize );
+
+        for( size_t i = 0; i < numGenes; i += ChunkSize )
+        {
+            auto chunk = newChunk();
+            auto first = genes.begin() + i;
+            chunk->insert( chunk->end(), std::make_move_iterator( first ), std::make_move_iterator( numGenes - i > ChunkSize ? first + ChunkSize : genes.end() ) );
+            chunks.push_back( std::move( chunk ) );
+        }
+    }
+
+    template< typename GeneType >
+    size_t
+    GeneList< GeneType >::size() const
+    {
+        return numGenes;
+    }
+
+    template< typename GeneType >
+    bool
+    GeneList< GeneType >::empty() const
+    {
+        return numGenes == 0;
+    }
+
+    template< typename GeneType >
+    inline
+    const GeneType&
+    GeneList< GeneType >::operator[]( size_t index ) const
+    {
+        assert( index < size() );
+
+        return (*chunks[ index >> ChunkBits ])[ index & ( ChunkSize - 1 ) ];
+    }
+
+    template< typename GeneType >
+    const GeneType&
+    GeneList< GeneType >::back() const
+    {
+        return chunks.back()->back();
+    }
+
+    template< typename GeneType >
+    typename GeneList< GeneType >::const_iterator
+    GeneList< GeneType >::begin() const
+    {
+        return const_iterator( chunks.data(), chunks.data() + chunks.size() );
+    }
+
+    template< typename GeneType >
+    typename GeneList< GeneType >::const_iterator
+    GeneList< GeneType >::end() const
+    {
+        return const_iterator( chunks.data() + chunks.size(), chunks.data() + chunks.size() );
+    }
+
+    template< typename GeneType >
+    std::vector< GeneType >
+    GeneList< GeneType >::to_vector() const
+    {
+        std::vector< GeneType > out;
+        out.reserve( size() );
+
+        for( const auto& chunk : chunks )
+        {
+            out.insert( out.end(), chunk->begin(), chunk->end() );
+        }
+
+        return out;
+    }
+
+    template< typename GeneType >
+    const GeneType *
+    GeneList< GeneType >::data() const
+    {
+        return chunks.size() == 1 ? chunks.front()->data() : nullptr;
+    }
+
+    template< typename GeneType >
+    size_t
+    GeneList< GeneType >::numChunks() const
+    {
+        return chunks.size();
+    }
+
+    template< typename GeneType >
+    size_t
+    GeneList< GeneType >::numSharedChunks() const
+    {
+        size_t out = 0;
+
+        for( const auto& chunk : chunks )
+        {
+            out += chunk.use_count() > 1 ? 1 : 0;
+        }
+
+        return out;
+    }
+
+    template< typename GeneType >
+    GeneType&
+    GeneList< GeneType >::operator[]( size_t index )
+    {
+        assert( index < size() );
+
+        return ownChunk( index >> ChunkBits )[ index & ( ChunkSize - 1 ) ];
+    }
+
+    template< typename GeneType >
+    void
+    GeneList< GeneType >::push_back( const GeneType& gene )
+    {
+        appendChunk().push_back( gene );
+        ++numGenes;
+    }
+
+    template< typename GeneType >
+    template< typename ... Args >
+    void
+    GeneList< GeneType >::emplace_back( Args&& ... args )
+    {
+        appendChunk().emplace_back( std::forward< Args >( args )... );
+        ++numGenes;
+    }
+
+    template< typename GeneType >
+    void
+    GeneList< GeneType >::reserve( size_t newCapacity )
+    {
+        chunks.reserve( ( newCapacity + ChunkSize - 1 ) / ChunkSize );
+    }
+
+    template< typename GeneType >
+    void
+    GeneList< GeneType >::clear()
+    {
+        chunks.clear();
+        numGenes = 0;
+    }
+
+    template< typename GeneType >
+    void
+    GeneList< GeneType >::shrink_to_fit()
+    {
+        chunks.shrink_to_fit();
+
+        if( !chunks.empty() && chunks.back()->size() < ChunkSize )
+        {
+            // a shared chunk is left alone, the copy that would trim it would cost more than the room it saves
+            if( chunks.back().use_count() == 1 )
+            {
+                std::atomic_thread_fence( std::memory_order_acquire );
+                chunks.back()->shrink_to_fit();
+            }
+        }
+    }
+
+    template< typename GeneType >
+    std::shared_ptr< typename GeneList< GeneType >::Chunk >
+    GeneList< GeneType >::newChunk()
+    {
+        auto chunk = std::make_shared< Chunk >();
+        chunk->reserve( ChunkSize );
+        return chunk;
+    }
+
+    template< typename GeneType >
+    typename GeneList< GeneType >::Chunk&
+    GeneList< GeneType >::ownChunk( size_t chunkIndex )
+    {
+        std::shared_ptr< Chunk >& chunk = chunks[ chunkIndex ];
+
+        if( chunk.use_count() == 1 )
+        {
+            // pairs with the release of the last other owner letting go of the chunk, so its reads are done before we write
+            std::atomic_thread_fence( std::memory_order_acquire );
+            return *chunk;
+        }
+
+        auto clone = newChunk();
+        clone->insert( clone->end(), chunk->begin(), chunk->end() );
+        chunk = std::move( clone );
+
+        return *chunk;
+    }
+
+    template< typename GeneType >
+    typename GeneList< GeneType >::Chunk&
+    GeneList< GeneType >::appendChunk()
+    {
+        if( chunks.empty() || chunks.back()->size() == ChunkSize )
+        {
+            chunks.push_back( newChunk() );
+            return *chunks.back();
+        }
+
+        return ownChunk( chunks.size() - 1 );
+    }
+}
+
+#endif // NEAT_GENE_LIST_INL_INCLUDED
@@ -33,6 +33,9 @@ namespace neat
 
             InnovationGenerator( rapidxml::xml_node<> * innovation_generator_node );
 
+            // counts up from the given ids instead of 0
+            InnovationGenerator( InnovationID first_innovation, NodeID first_node ) : InnovationGenerator() { innovationCounter = first_innovation; nodeCounter = first_node; }
+
             inline NodeDef GetNextNode( double tMin, double tMax, double vDec, double aDec, uint64_t pF, uint64_t pS, NodeType type );
             inline ConnectionDef GetNextConnection( NodeID src, NodeID dst, double weight, uint64_t length );
 
@@ -47,6 +50,8 @@ namespace neat
 
             inline NodeID getNextNodeIDAndIncrement();
             inline NodeID getLastNodeID() const;
+
+            friend class Population;
     };
 }
 
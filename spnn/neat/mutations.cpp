@@ -31,13 +31,13 @@ namespace neat
             return sqrt( -2.0 * logl( u ) ) * cos( two_pi * v );
         }
 
-        std::vector< NodeDef >&
+        GeneList< NodeDef >&
         Mutation_base::GetNodeList( NetworkGenotype& genotype )
         {
             return genotype.nodeGenotype;
         }
 
-        std::vector< ConnectionDef >&
+        GeneList< ConnectionDef >&
         Mutation_base::GetConnList( NetworkGenotype& genotype )
         {
             return genotype.connectionGenotype;
@@ -92,7 +92,7 @@ namespace neat
         uint64_t
         Mutation_Multi::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator& innovationTracker, const MutationRates& rates, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             // TODO(dot##11/28/2018): figure out a way to best take the bool returns of the called mutators and express them in this functions bool return.
 
@@ -183,7 +183,7 @@ namespace neat
         uint64_t
         Mutation_Multi_one::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator& innovationTracker, const MutationRates& rates, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             if( !numMutators() )
             {
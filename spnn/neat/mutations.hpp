@@ -40,8 +40,8 @@ namespace neat
             protected:
 
                 // support, 'cause we need to get to the protected data in the NodeGenotype, and I'm not adding 20+ friends to it
-                static std::vector< NodeDef >& GetNodeList( NetworkGenotype& genotype );
-                static std::vector< ConnectionDef >& GetConnList( NetworkGenotype& genotype );
+                static GeneList< NodeDef >& GetNodeList( NetworkGenotype& genotype );
+                static GeneList< ConnectionDef >& GetConnList( NetworkGenotype& genotype );
         };
 
         class MutationsFileLoadFactory
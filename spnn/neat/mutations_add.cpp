@@ -16,7 +16,7 @@ namespace neat
         uint64_t
         Mutation_Add_node::operator()(  NetworkGenotype& genotypeToMutate, InnovationGenerator& innovationTracker, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             // get references for the genotypes nodes and connections
             auto& nodeList = GetNodeList( genotypeToMutate );
@@ -68,7 +68,7 @@ namespace neat
         uint64_t
         Mutation_Add_conn::operator()(  NetworkGenotype& genotypeToMutate, InnovationGenerator& innovationTracker, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate );
 
@@ -133,7 +133,7 @@ namespace neat
         {
             // TODO(dot##1/17/2019): Fix the comments, they currently do not make sense
 
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             // get references for the genotypes nodes and connections
             auto& nodeList = GetNodeList( genotypeToMutate );
@@ -266,7 +266,7 @@ namespace neat
         uint64_t
         Mutation_Add_conn_dup::operator()(  NetworkGenotype& genotypeToMutate, InnovationGenerator& innovationTracker, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& connList = GetConnList( genotypeToMutate );
 
@@ -306,7 +306,7 @@ namespace neat
         uint64_t
         Mutation_Add_conn_multi_in::operator()(  NetworkGenotype& genotypeToMutate, InnovationGenerator& innovationTracker, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             // get references for the genotypes nodes and connections
             auto& nodeList = GetNodeList( genotypeToMutate );
@@ -374,7 +374,7 @@ namespace neat
         uint64_t
         Mutation_Add_conn_multi_out::operator()(  NetworkGenotype& genotypeToMutate, InnovationGenerator& innovationTracker, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             // get references for the genotypes nodes and connections
             auto& nodeList = GetNodeList( genotypeToMutate );
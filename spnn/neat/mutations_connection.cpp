@@ -11,7 +11,7 @@ namespace neat
         Mutation_Conn_weight::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates& rates, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& connList = GetConnList( genotypeToMutate ); // get the connection list
             if( connList.empty() ) { return 0; } // cant get the connection from an empty list
@@ -32,7 +32,7 @@ namespace neat
         Mutation_Conn_weight_new::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& connList = GetConnList( genotypeToMutate ); // get the connection list
             if( connList.empty() ) { return 0; } // cant get the connection from an empty list
@@ -51,7 +51,7 @@ namespace neat
         Mutation_Conn_length::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates& rates, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& connList = GetConnList( genotypeToMutate ); // get the connection list
             if( connList.empty() ) { return 0; } // cant get the connection from an empty list
@@ -72,7 +72,7 @@ namespace neat
         Mutation_Conn_length_new::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& connList = GetConnList( genotypeToMutate ); // get the connection list
             if( connList.empty() ) { return 0; } // cant get the connection from an empty list
@@ -91,7 +91,7 @@ namespace neat
         Mutation_Conn_enable::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates&, const MutationLimits&, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& connList = GetConnList( genotypeToMutate ); // get the connection list
             if( connList.empty() ) { return 0; } // cant get the connection from an empty list
@@ -11,7 +11,7 @@ namespace neat
         Mutation_Node_thresh_min::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates& rates, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -32,7 +32,7 @@ namespace neat
         Mutation_Node_thresh_min_new::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -51,7 +51,7 @@ namespace neat
         Mutation_Node_thresh_max::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates& rates, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -72,7 +72,7 @@ namespace neat
         Mutation_Node_thresh_max_new::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -91,7 +91,7 @@ namespace neat
         Mutation_Node_decays_value::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates& rates, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -112,7 +112,7 @@ namespace neat
         Mutation_Node_decays_value_new::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -131,7 +131,7 @@ namespace neat
         Mutation_Node_decays_activ::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates& rates, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -152,7 +152,7 @@ namespace neat
         Mutation_Node_decays_activ_new::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -171,7 +171,7 @@ namespace neat
         Mutation_Node_pulses_fast::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates& rates, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -192,7 +192,7 @@ namespace neat
         Mutation_Node_pulses_fast_new::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -211,7 +211,7 @@ namespace neat
         Mutation_Node_pulses_slow::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates& rates, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -232,7 +232,7 @@ namespace neat
         Mutation_Node_pulses_slow_new::operator()( NetworkGenotype& genotypeToMutate, InnovationGenerator&, const MutationRates&, const MutationLimits& limits, std::shared_ptr< Rand::RandomFunctor > rand ) const
         {
             // make sure we have a functioning random number generator
-            if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+            if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
             auto& nodeList = GetNodeList( genotypeToMutate ); // get the node list
             if( nodeList.empty() ) { return 0; } // cant get the node from an empty list
@@ -16,7 +16,7 @@ namespace neat
     typedef uint64_t InnovationID;
     typedef uint64_t SpeciesID;
 
-    typedef std::function< void( const spnn::neuron& ) > NodeCallback;
+    typedef std::function< void( const spnn::compiled_neuron& ) > NodeCallback;
 
     enum class NodeType : uint8_t { Hidden, Input, Output };
 
@@ -122,6 +122,7 @@ namespace neat
 
 #include "neat.inl"
 
+#include "content_hasher.hpp"
 #include "population.hpp"
 #include "network.hpp"
 #include "species.hpp"
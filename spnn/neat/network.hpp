@@ -12,6 +12,7 @@ namespace neat
     class NetworkGenotype;
 }
 
+#include "gene_list.hpp"
 #include "species.hpp"
 #include "population.hpp"
 #include "mutations.hpp"
@@ -19,15 +20,13 @@ namespace neat
 
 namespace neat
 {
-    class NetworkPhenotype : protected spnn::network
+    class NetworkPhenotype : protected spnn::compiled_network
     {
         private:
 
             // data
 
-            std::vector< spnn::neuron >  neuronData;
-            std::vector< spnn::neuron* > inputNeurons;
-            std::vector< spnn::neuron* > outputNeurons;
+            std::vector< spnn::compiled_network::index_type > outputNeurons;
 
         protected:
 
@@ -58,15 +57,16 @@ namespace neat
 
             void printNetworkState( std::ostream& out ) const;
 
-            using spnn::network::Time;
-            using spnn::network::DeltaTime;
-            using spnn::network::QueueSize;
+            using spnn::compiled_network::Time;
+            using spnn::compiled_network::DeltaTime;
+            using spnn::compiled_network::QueueSize;
 
-            using spnn::network::PulsesProcessed;
-            using spnn::network::NeuronsProcessed;
+            using spnn::compiled_network::PulsesProcessed;
+            using spnn::compiled_network::NeuronsProcessed;
+            using spnn::compiled_network::InputsProcessed;
 
-            using spnn::network::PulsesProcessedLastTick;
-            using spnn::network::NeuronsProcessedLastTick;
+            using spnn::compiled_network::PulsesProcessedLastTick;
+            using spnn::compiled_network::NeuronsProcessedLastTick;
 
         protected:
 
@@ -77,7 +77,7 @@ namespace neat
             // construction functions
 
             void AddNode( NodeDef nodeDefinition );
-            void AddNode( NodeID nodeID, NodeType type, const spnn::neuron& neuron );
+            void AddNode( NodeID nodeID, NodeType type, double tMin, double tMax, uint64_t pFast, uint64_t pSlow, double vDecay, double aDecay );
             void AddConnection( ConnectionDef connDefinition );
             void AddConnection( NodeID srcID, NodeID dstID, double weight, uint64_t len );
 
@@ -88,7 +88,7 @@ namespace neat
             bool setInputValues( const std::vector< double >& values );
             bool setOutputCallbacks( const std::vector< NodeCallback >& callbacks );
 
-            size_t QueuePulse( spnn::neuron * neuron, double value, uint64_t arrivalTime = 0 );
+            size_t QueuePulse( spnn::compiled_network::index_type neuron, double value, uint64_t arrivalTime = 0 );
 
             void resetNetworkState();
 
@@ -107,8 +107,9 @@ namespace neat
 
             // structure
 
-            std::vector< NodeDef >          nodeGenotype;
-            std::vector< ConnectionDef >    connectionGenotype;
+            // copies of a genotype share their genes, see GeneList
+            GeneList< NodeDef >             nodeGenotype;
+            GeneList< ConnectionDef >       connectionGenotype;
 
             SpeciesID parentSpeciesID;
 
@@ -134,14 +135,17 @@ namespace neat
 
             SpeciesID getParentSpeciesID() const;
 
-            const std::vector< NodeDef >& getNodes() const;
-            const std::vector< ConnectionDef >& getConnections() const;
+            const GeneList< NodeDef >& getNodes() const;
+            const GeneList< ConnectionDef >& getConnections() const;
 
             size_t getNumReachableNodes() const;
             size_t getNumActiveConnections() const;
             size_t getNumReachableActiveConnections() const;
             void getNumReachableNumActiveNodes( size_t& reachable, size_t& active ) const;
 
+            // hash of everything that shapes the phenotype, stable between runs and machines of the same endianness
+            uint64_t getContentHash() const;
+
             std::shared_ptr< NetworkPhenotype > getNewNetworkPhenotype( uint64_t dTime = 1 ) const;
 
             void printGenotype( std::ostream& out = std::cout, const std::string& name = "" ) const;
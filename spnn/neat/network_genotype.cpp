@@ -1,9 +1,11 @@
 #include <iostream>
 #include <string>
 #include <numeric>
+#include <cstring>
 
 #include <cassert>
 
+#include "content_hasher.hpp"
 #include "network.hpp"
 
 namespace neat
@@ -50,18 +52,52 @@ namespace neat
         return parentSpeciesID;
     }
 
-    const std::vector< NodeDef >&
+    const GeneList< NodeDef >&
     NetworkGenotype::getNodes() const
     {
         return nodeGenotype;
     }
 
-    const std::vector< ConnectionDef >&
+    const GeneList< ConnectionDef >&
     NetworkGenotype::getConnections() const
     {
         return connectionGenotype;
     }
 
+    uint64_t
+    NetworkGenotype::getContentHash() const
+    {
+        ContentHasher hasher;
+
+        // field by field, so padding never ends up in the hash
+        hasher.add( uint64_t( nodeGenotype.size() ) );
+        for( const auto& node : nodeGenotype )
+        {
+            hasher.add( node.innovation );
+            hasher.add( node.ID );
+            hasher.add( node.thresholdMin );
+            hasher.add( node.thresholdMax );
+            hasher.add( node.valueDecay );
+            hasher.add( node.activDecay );
+            hasher.add( node.pulseFast );
+            hasher.add( node.pulseSlow );
+            hasher.add( node.type );
+        }
+
+        hasher.add( uint64_t( connectionGenotype.size() ) );
+        for( const auto& connection : connectionGenotype )
+        {
+            hasher.add( connection.innovation );
+            hasher.add( connection.sourceID );
+            hasher.add( connection.destinationID );
+            hasher.add( connection.weight );
+            hasher.add( connection.length );
+            hasher.add( connection.enabled );
+        }
+
+        return hasher.value();
+    }
+
     size_t
     NetworkGenotype::getNumReachableNodes() const
     {
@@ -10,13 +10,13 @@ namespace neat
 {
 
     NetworkPhenotype::NetworkPhenotype()
-         : spnn::network( 1 ), neuronData(), inputNeurons(), outputNeurons(), neuronIDMap(), neuronIDs(), neuronTypes()
+         : spnn::compiled_network( 1 ), outputNeurons(), neuronIDMap(), neuronIDs(), neuronTypes()
     {
         /*  */
     }
 
     NetworkPhenotype::NetworkPhenotype( uint64_t dTime )
-         : spnn::network( dTime ), neuronData(), inputNeurons(), outputNeurons(), neuronIDMap(), neuronIDs(), neuronTypes()
+         : spnn::compiled_network( dTime ), outputNeurons(), neuronIDMap(), neuronIDs(), neuronTypes()
     {
         /*  */
     }
@@ -29,7 +29,7 @@ namespace neat
     size_t
     NetworkPhenotype::numInputs() const
     {
-        return inputNeurons.size();
+        return NumInputs();
     }
 
     size_t
@@ -41,13 +41,13 @@ namespace neat
     size_t
     NetworkPhenotype::numNeurons() const
     {
-        return neuronData.size();
+        return NumNeurons();
     }
 
     size_t
     NetworkPhenotype::numSynapses() const
     {
-        return std::accumulate( neurons.begin(), neurons.end(), size_t( 0 ), []( const auto & running_sum, const auto & neuron ){ return running_sum + neuron->getNumSynapses(); } );
+        return NumSynapses();
     }
 
     void
@@ -59,8 +59,10 @@ namespace neat
         out << "\tLastTick: { pulses = " << PulsesProcessedLastTick() << ", neurons = " << NeuronsProcessedLastTick() << "}\n";
         out << "\tRawNeurons:\n\t{\n";
 
-        for( auto& neuron : neuronData )
+        for( size_t i = 0; i < NumNeurons(); ++i )
         {
+            auto neuron = Neuron( spnn::compiled_network::index_type( i ) );
+
             out << "\t\tNeuron " << neuron.getID() << ": { ";
             out << "value = " << neuron.getValue() << ", ";
             out << "rcount = " << neuron.getRefractoryCount() << ", ";
@@ -87,31 +89,20 @@ namespace neat
         double   vDecay = nodeDefinition.valueDecay;
         double   aDecay = nodeDefinition.activDecay;
 
-        // make the Neuron!
-        spnn::neuron neuron( tMin, tMax, pFast, pSlow, vDecay, aDecay /*, std::vector< spnn::synapse >{} */ );
-
-        /*if( nodeDefinition.type == NodeType::Output )
-        {
-            neuron.setCallbackFunction( nodeDefinition.callback );
-        }*/
-
         // add it with the ID and type
-        AddNode( nodeDefinition.ID, nodeDefinition.type, neuron );
+        AddNode( nodeDefinition.ID, nodeDefinition.type, tMin, tMax, pFast, pSlow, vDecay, aDecay );
     }
 
     void
-    NetworkPhenotype::AddNode( NodeID nodeID, NodeType type, const spnn::neuron& neuron )
+    NetworkPhenotype::AddNode( NodeID nodeID, NodeType type, double tMin, double tMax, uint64_t pFast, uint64_t pSlow, double vDecay, double aDecay )
     {
         // make sure we haven't finalized yet
-        assert( neuronIDs.size() == neuronData.size() );
+        assert( !IsFinalized() && neuronIDs.size() == NumNeurons() );
 
-        // add the neuron id to the index of the next neuron in neuronData
-        neuronIDMap.emplace( nodeID, neuronData.size() );
+        // make the Neuron! and add the neuron id to its index
+        neuronIDMap.emplace( nodeID, AddNeuron( tMin, tMax, pFast, pSlow, vDecay, aDecay ) );
 
-        // add neuron as the next neuron in neuronData
-        neuronData.push_back( neuron );
-
-        // for later reference add the nodeID to the end of neuronIDs to correspond with neuronData
+        // for later reference add the nodeID to the end of neuronIDs to correspond with the neuron indexes
         neuronIDs.push_back( nodeID );
 
         // add the node type to the node type vector for finalization
@@ -142,43 +133,40 @@ namespace neat
         // both must exist!
         if( sourceID_it != end_it && destinationID_it != end_it )
         {
-            // finally the pointers to the source and destination neurons
-            spnn::neuron * source      = &neuronData[ sourceID_it->second ];
-            spnn::neuron * destination = &neuronData[ destinationID_it->second ];
-
-            // add the synapse to the source neuron pointing to the destination neuron
-            source->AddSynapse( spnn::synapse( destination, len, weight ) );
+            // add the synapse from the source neuron pointing to the destination neuron
+            AddSynapse( index_type( sourceID_it->second ), index_type( destinationID_it->second ), len, weight );
         }
     }
 
     void
     NetworkPhenotype::Finalize()
     {
-        assert( neuronData.size() == neuronTypes.size() );
+        assert( NumNeurons() == neuronTypes.size() );
 
-        std::set< spnn::neuron * > verification_neurons;
+        // pack the synapses into their final layout
+        spnn::compiled_network::Finalize();
 
-        for( size_t i = 0; i < neuronData.size(); ++i )
-        {
-            spnn::neuron * neuron = &neuronData[ i ];
-
-            AddNeuron( neuron );
-            verification_neurons.emplace( neuron );
+        std::vector< index_type > inputNeurons;
 
+        for( size_t i = 0; i < NumNeurons(); ++i )
+        {
             switch( neuronTypes[i] )
             {
-                case NodeType::Input:   inputNeurons.push_back( neuron ); break;
-                case NodeType::Output: outputNeurons.push_back( neuron ); break;
+                case NodeType::Input:   inputNeurons.push_back( index_type( i ) ); break;
+                case NodeType::Output: outputNeurons.push_back( index_type( i ) ); break;
                 case NodeType::Hidden: break;
                 default:               break;
             }
-
-            //neuronData[i].setCallbackFunction( []( const spnn::neuron& n ){ std::cout << "spnn::neuron ID" << n.getID() << " activated" << std::endl; } );
         }
 
-        assert( Verify( verification_neurons ) && "the network must only contain pointers to neurons that are in the network." );
+        assert( Verify() && "the network must only contain synapses to neurons that are in the network." );
+
+        // the inputs are written through the input port, not the pulse queue
+        setInputNeurons( inputNeurons );
+
+        // inputs arrive once every few ticks and most neurons are quiet in between, so only tick the ones with something to do
+        setEventDriven( true );
 
-        inputNeurons.shrink_to_fit();
         outputNeurons.shrink_to_fit();
 
         neuronTypes.clear();
@@ -195,27 +183,8 @@ namespace neat
     bool
     NetworkPhenotype::setInputValues( const std::vector< double >& values )
     {
-        // make sure we are the right size!
-        if( !values.size() || !inputNeurons.size() || values.size() < inputNeurons.size() )
-        {
-            // say something went wrong
-            return false;
-        }
-
-         // only go for as many callbacks as nodes exist
-        size_t numValues = std::min( values.size(), inputNeurons.size() );
-
-        // set the output values to those in the given list
-        for( size_t i = 0; i < numValues; ++i )
-        {
-            if( !QueuePulse( inputNeurons[i], values[i] - inputNeurons[i]->getValue(), 0 ) )
-            {
-                return false;
-            }
-        }
-
-        // everything went right
-        return true;
+        // the input port checks that there is a value for every input neuron, and moves them to these values at the next tick
+        return spnn::compiled_network::setInputValues( values.data(), values.size() );
     }
 
     bool
@@ -234,7 +203,7 @@ namespace neat
         // set the output callbacks to those in the given list
         for( size_t i = 0; i < numCallbacks; ++i )
         {
-            outputNeurons[i]->setCallbackFunction( callbacks[i] );
+            setCallbackFunction( outputNeurons[i], callbacks[i] );
         }
 
         // everything went right
@@ -242,14 +211,14 @@ namespace neat
     }
 
     size_t
-    NetworkPhenotype::QueuePulse( spnn::neuron * neuron, double value, uint64_t arrivalTime )
+    NetworkPhenotype::QueuePulse( spnn::compiled_network::index_type neuron, double value, uint64_t arrivalTime )
     {
-        return spnn::network::QueuePulse( spnn::pulse( neuron, arrivalTime, value ) );
+        return spnn::compiled_network::QueuePulse( neuron, arrivalTime, value );
     }
 
     void
     NetworkPhenotype::resetNetworkState()
     {
-        spnn::network::clear_network_state();
+        spnn::compiled_network::clear_network_state();
     }
 }
@@ -7,6 +7,8 @@
 
 namespace neat
 {
+    const uint64_t Population::PendingIDs;
+
     Population::DbgGenerationCallbacks::DbgGenerationCallbacks()
      :
         begin( nullptr ),
@@ -64,6 +66,7 @@ namespace neat
         mutationRates( mutRate ),
         mutatorFunctor( mutator ),
         fitnessCalculatorFactory( fitFactory ),
+        fitnessCache( nullptr ),
         generationDataToKeep( gensToKeep ),
         generationLog(),
         minSpeciesSize( minSpec ),
@@ -156,58 +159,149 @@ namespace neat
         return massExtinctionCount;
     }
 
+    void
+    Population::setFitnessCache( std::shared_ptr< FitnessCache > cache )
+    {
+        fitnessCache = cache;
+    }
+
+    std::shared_ptr< FitnessCache >
+    Population::getFitnessCache() const
+    {
+        return fitnessCache;
+    }
+
     uint64_t
     Population::mutatePopulation( tpl::pool& thread_pool, std::shared_ptr< Rand::RandomFunctor > rand )
     {
-        // make sure we have a functioning random number generator
-        if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+        return mutatePopulation( thread_pool, *mutatorFunctor, rand );
+    }
 
-        std::atomic< uint64_t > num_muts{ 0 };
+    uint64_t
+    Population::mutatePopulation( tpl::pool& thread_pool, neat::Mutations::Mutation_base& custom_mutator, std::shared_ptr< Rand::RandomFunctor > rand )
+    {
+        std::vector< NetworkGenotype* > genotypes_to_mutate;
+        genotypes_to_mutate.reserve( populationData.size() );
 
         // mutate each genotype present in the population
-        tpl::for_each( thread_pool, populationData.begin(), populationData.end(), [&]( auto& genotype )
+        for( auto& genotype : populationData )
         {
-            auto _rand = std::make_shared< Rand::Random_Unsafe >( rand->Int() );
-            num_muts += (*mutatorFunctor)( genotype, *innovationCounter, mutationRates, mutationLimits, _rand );
-        } );
+            genotypes_to_mutate.push_back( &genotype );
+        }
 
-        return num_muts;
+        return mutateGenotypes( thread_pool, genotypes_to_mutate, custom_mutator, rand );
     }
 
     uint64_t
-    Population::mutatePopulation( tpl::pool& thread_pool, neat::Mutations::Mutation_base& custom_mutator, std::shared_ptr< Rand::RandomFunctor > rand )
+    Population::mutatePopulation( tpl::pool& thread_pool, std::vector< NetworkGenotype* > genotypes_to_mutate, std::shared_ptr< Rand::RandomFunctor > rand )
     {
-        // make sure we have a functioning random number generator
-        if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+        return mutateGenotypes( thread_pool, genotypes_to_mutate, *mutatorFunctor, rand );
+    }
+
+    uint64_t
+    Population::mutateGenotypes( tpl::pool& thread_pool, const std::vector< NetworkGenotype* >& genotypes_to_mutate, Mutations::Mutation_base& mutator, std::shared_ptr< Rand::RandomFunctor > rand )
+    {
+        // one draw, the rest come from a stream of their own for each genotype, so the mutations do not depend on the order the threads run in
+        const uintmax_t seed = rand ? rand->Int() : Rand::Int();
 
         std::atomic< uint64_t > num_muts{ 0 };
 
-        // mutate each genotype present in the population
-        tpl::for_each( thread_pool, populationData.begin(), populationData.end(), [&]( auto& genotype )
+        // the ids each genotype drew, so that the structural mutations do not take their ids in the order the threads finish
+        std::vector< std::unique_ptr< InnovationGenerator > > pending( genotypes_to_mutate.size() );
+
+        // for_each hands out the elements in place, so their position in the list picks the stream
+        tpl::for_each( thread_pool, genotypes_to_mutate.begin(), genotypes_to_mutate.end(), [&]( NetworkGenotype * const & genotype )
         {
-            auto _rand = std::make_shared< Rand::Random_Unsafe >( rand->Int() );
-            num_muts += custom_mutator( genotype, *innovationCounter, mutationRates, mutationLimits, _rand );
+            const size_t index = &genotype - genotypes_to_mutate.data();
+
+            pending[ index ] = std::make_unique< InnovationGenerator >( PendingIDs, PendingIDs );
+
+            auto _rand = std::make_shared< Rand::Random_Counter >( seed, generationCount, index, uint64_t( RandomPurpose::Mutation ) );
+            num_muts += mutator( *genotype, *pending[ index ], mutationRates, mutationLimits, _rand );
         } );
 
+        // hand out the real ids in list order
+        for( size_t i = 0; i < genotypes_to_mutate.size(); ++i )
+        {
+            assignPendingIDs( *genotypes_to_mutate[ i ], *pending[ i ] );
+        }
+
         return num_muts;
     }
 
-    uint64_t
-    Population::mutatePopulation( tpl::pool& thread_pool, std::vector< NetworkGenotype* > genotypes_to_mutate, std::shared_ptr< Rand::RandomFunctor > rand )
+    void
+    Population::assignPendingIDs( NetworkGenotype& genotype, const InnovationGenerator& pending )
     {
-        // make sure we have a functioning random number generator
-        if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+        const size_t numNodes = pending.getLastNodeID() - PendingIDs;
+        const size_t numInnovations = pending.getLastInnovationID() - PendingIDs;
 
-        std::atomic< uint64_t > num_muts{ 0 };
+        // no structural mutations, nothing to swap
+        if( numNodes == 0 && numInnovations == 0 )
+        {
+            return;
+        }
 
-        // mutate each genotype present in the population
-        tpl::for_each( thread_pool, genotypes_to_mutate.begin(), genotypes_to_mutate.end(), [&]( auto * genotype )
+        // the nodes take their ids in the order they were added
+        std::vector< NodeID > nodeIDs( numNodes );
+        for( auto& id : nodeIDs )
         {
-            auto _rand = std::make_shared< Rand::Random_Unsafe >( rand->Int() );
-            num_muts += (*mutatorFunctor)( *genotype, *innovationCounter, mutationRates, mutationLimits, _rand );
-        } );
+            id = innovationCounter->getNextNodeIDAndIncrement();
+        }
 
-        return num_muts;
+        auto realNodeID = [&]( NodeID id ){ return id >= PendingIDs ? nodeIDs[ id - PendingIDs ] : id; };
+
+        auto& nodeList = genotype.nodeGenotype;
+        auto& connList = genotype.connectionGenotype;
+
+        for( size_t i = 0; i < nodeList.size(); ++i )
+        {
+            // only write to the genes that change, writing clones a shared chunk
+            if( static_cast< const GeneList< NodeDef >& >( nodeList )[ i ].ID >= PendingIDs )
+            {
+                nodeList[ i ].ID = realNodeID( nodeList[ i ].ID );
+            }
+        }
+
+        // the connection each pending innovation was given to, every connection with the same innovation joins the same two nodes
+        std::vector< const ConnectionDef * > innovationConns( numInnovations, nullptr );
+        for( const auto& conn : connList )
+        {
+            if( conn.innovation >= PendingIDs )
+            {
+                innovationConns[ conn.innovation - PendingIDs ] = &conn;
+            }
+        }
+
+        // the connections take their innovations in the order they were drawn, sharing any this generation already gave the same two nodes
+        std::vector< InnovationID > innovations( numInnovations );
+        for( size_t i = 0; i < numInnovations; ++i )
+        {
+            // drawn, but then not kept by the mutation
+            if( innovationConns[ i ] == nullptr )
+            {
+                continue;
+            }
+
+            innovations[ i ] = innovationCounter->GetNextConnection( realNodeID( innovationConns[ i ]->sourceID ), realNodeID( innovationConns[ i ]->destinationID ), 0.0, 0 ).innovation;
+        }
+
+        for( size_t i = 0; i < connList.size(); ++i )
+        {
+            const ConnectionDef& conn = static_cast< const GeneList< ConnectionDef >& >( connList )[ i ];
+
+            if( conn.innovation >= PendingIDs || conn.sourceID >= PendingIDs || conn.destinationID >= PendingIDs )
+            {
+                ConnectionDef& pendingConn = connList[ i ];
+
+                pendingConn.sourceID = realNodeID( pendingConn.sourceID );
+                pendingConn.destinationID = realNodeID( pendingConn.destinationID );
+
+                if( pendingConn.innovation >= PendingIDs )
+                {
+                    pendingConn.innovation = innovations[ pendingConn.innovation - PendingIDs ];
+                }
+            }
+        }
     }
 
     void
@@ -239,7 +333,7 @@ namespace neat
         const size_t populationSize = populationData.size();
 
         // make sure we have a functioning random number generator
-        if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
+        if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
         if( dbg && dbg_callbacks->speciate_begin ) dbg_callbacks->speciate_begin();
 
@@ -385,9 +479,8 @@ namespace neat
                 speciesFitnessRatio.emplace( species_fitness.species_id, species_fitness.species_fitness );
 
                 // std::vector< std::pair<long double, const NetworkGenotype * > >
-                auto _rand =  std::make_shared< Rand::Random_Safe >( rand->Int() );
                 species_sort_futures.emplace_back( thread_pool.submit(
-                [&archetype_mutex,this,_rand]( auto& species_data )
+                [&archetype_mutex,this]( auto& species_data )
                 {
                     species_data.sort_species_geotypes_by_fitness();
 
@@ -532,6 +625,9 @@ namespace neat
 
             std::list< future_package > genotype_futures;
 
+            // one draw for all the splicing, each offspring gets a stream of its own from it
+            const uintmax_t spliceSeed = rand->Int();
+
             for( const auto s : speciesNextGenCount )
             {
                 const SpeciesID species = s.first;
@@ -599,7 +695,8 @@ namespace neat
                         continue;
                     }
 
-                    auto _rand = std::make_shared< Rand::Random_Unsafe >( rand->Int() );
+                    // each offspring splices with a stream of its own, picked by its place in the next generation
+                    auto _rand = std::make_shared< Rand::Random_Counter >( spliceSeed, generationCount, genotype_futures.size(), uint64_t( RandomPurpose::Splice ) );
                     using overload_type = NetworkGenotype( const NetworkGenotype&, const NetworkGenotype&, std::shared_ptr< Rand::RandomFunctor > );
                     genotype_futures.push_back(
                             {
@@ -692,7 +789,7 @@ namespace neat
     RandomIndexes( size_t num, std::shared_ptr< Rand::RandomFunctor > rand )
     {
         // make sure we have a functioning random number generator
-        if( !rand ) rand = std::make_shared< Rand::Random_Unsafe >( Rand::Int() );
+        if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
 
         // init out to contain the numbers from 0 to num-1
         std::vector< size_t > out( num );
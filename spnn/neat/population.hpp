@@ -108,6 +108,9 @@ namespace neat
 
             uint64_t generationCount;
 
+            // what a random stream is drawn for, so that a genotype gets different streams for each use in a generation, see Rand::Random_Counter
+            enum class RandomPurpose : uint64_t { Mutation = 1, Splice };
+
             std::unique_ptr< NetworkGenotype > initialGenotypeTemplate;
 
         protected:
@@ -125,6 +128,7 @@ namespace neat
             std::shared_ptr< Mutations::Mutation_base > mutatorFunctor;
 
             std::shared_ptr< FitnessFactory > fitnessCalculatorFactory;
+            std::shared_ptr< FitnessCache > fitnessCache; // only used with deterministic fitness factories
 
             size_t generationDataToKeep;
             std::deque< std::shared_ptr< Generation > > generationLog;
@@ -169,6 +173,9 @@ namespace neat
             const std::shared_ptr< Generation > getLastGenerationData() const;
             uint64_t getNumMassExtinctions() const;
 
+            void setFitnessCache( std::shared_ptr< FitnessCache > cache );
+            std::shared_ptr< FitnessCache > getFitnessCache() const;
+
             std::map< SpeciesID, long double > getSpeciesFitness( tpl::pool& thread_pool );
             PopulationFitness getSpeciesAndNetworkFitness( tpl::pool& thread_pool );
             PopulationFitness getSpeciesAndNetworkFitness( tpl::pool& thread_pool, const std::map< SpeciesID, std::vector< NetworkGenotype * > >& speciatedPopulation, std::shared_ptr< Rand::RandomFunctor > rand = nullptr );
@@ -232,6 +239,15 @@ namespace neat
         private:
 
             NetworkGenotype getDefaultNetworkCopy( const MutationLimits& limits ) const;
+
+            // the genotypes are mutated on the threads with ids from a generator of their own, the real ids are handed out afterwards in list order
+            uint64_t mutateGenotypes( tpl::pool& thread_pool, const std::vector< NetworkGenotype* >& genotypes_to_mutate, Mutations::Mutation_base& mutator, std::shared_ptr< Rand::RandomFunctor > rand );
+
+            // swaps the ids a genotype drew from its pending generator for ids from innovationCounter
+            void assignPendingIDs( NetworkGenotype& genotype, const InnovationGenerator& pending );
+
+            // where the pending generators start counting, far above any id innovationCounter will reach
+            static const uint64_t PendingIDs = uint64_t( 1 ) << 62;
     };
 
     std::vector< size_t > RandomIndexes( size_t num, std::shared_ptr< Rand::RandomFunctor > rand );
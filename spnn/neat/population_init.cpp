@@ -42,9 +42,12 @@ namespace neat
     {
         // TODO(dot##1/15/2019): make this use a given random functor rather than the global one.
 
-        NetworkGenotype out;
-        out.nodeGenotype.reserve( initialGenotypeTemplate->nodeGenotype.size() );
-        out.connectionGenotype.reserve( initialGenotypeTemplate->connectionGenotype.size() );
+        // built as plain vectors, and then split into the genotype's gene chunks, which copies of it share until they write to them.
+        //   every value is drawn per genotype, so these chunks are not shared with the rest of the first generation, only with their copies
+        std::vector< NodeDef > nodes;
+        std::vector< ConnectionDef > connections;
+        nodes.reserve( initialGenotypeTemplate->nodeGenotype.size() );
+        connections.reserve( initialGenotypeTemplate->connectionGenotype.size() );
 
         // add the nodes from the template to the new genotype
         for( NodeDef node : initialGenotypeTemplate->nodeGenotype )
@@ -70,7 +73,7 @@ namespace neat
             }
 
             // add the node to the output genotype
-            out.nodeGenotype.push_back( node );
+            nodes.push_back( node );
         }
 
         // add the connections from the template to the new genotype
@@ -87,9 +90,13 @@ namespace neat
             }
 
             // add the connection to the output genotype
-            out.connectionGenotype.push_back( connDef );
+            connections.push_back( connDef );
         }
 
+        NetworkGenotype out;
+        out.nodeGenotype = GeneList< NodeDef >( std::move( nodes ) );
+        out.connectionGenotype = GeneList< ConnectionDef >( std::move( connections ) );
+
         // and we are done, return the output genotype
         return out;
     }
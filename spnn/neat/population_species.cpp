@@ -104,16 +104,32 @@ namespace neat
             const NetworkGenotype * genotype;
         };
 
-        auto fitness_lambda = []( SpeciesID species, const NetworkGenotype * genotype, std::shared_ptr< FitnessFactory > fitness_factory ) -> fitness_package
+        // scores are only reused when the fitness factory scores a genotype the same way every time
+        std::shared_ptr< FitnessCache > fitness_cache = fitnessCalculatorFactory->isDeterministic() ? fitnessCache : nullptr;
+        const uint64_t configuration_hash = fitness_cache ? fitnessCalculatorFactory->getConfigurationHash() : 0;
+
+        const uint64_t generation = generationCount;
+        const NetworkGenotype * const firstGenotype = populationData.data();
+
+        auto fitness_lambda = [fitness_cache,configuration_hash,generation,firstGenotype]( SpeciesID species, const NetworkGenotype * genotype, std::shared_ptr< FitnessFactory > fitness_factory ) -> fitness_package
         {
             long double fitScore = 0.0;
+
+            const uint64_t genotype_hash = fitness_cache ? genotype->getContentHash() : 0;
+
+            if( fitness_cache && fitness_cache->getFitness( genotype_hash, configuration_hash, fitScore ) )
+            {
+                return { species, fitScore, genotype };
+            }
+
             size_t count = fitness_factory->numTimesToTest();
 
             auto network_phenotype = genotype->getNewNetworkPhenotype();
 
             while( count-- )
             {
-                auto fitnessCalculator = fitness_factory->getNewFitnessCalculator( network_phenotype, count );
+                // the genotypes come from populationData, so the index stays the same whichever thread runs it
+                auto fitnessCalculator = fitness_factory->getNewFitnessCalculatorFor( network_phenotype, count, generation, genotype - firstGenotype );
 
                 fitnessCalculator->Run();
 
@@ -125,6 +141,11 @@ namespace neat
 
             fitScore /= (long double)( fitness_factory->numTimesToTest() );
 
+            if( fitness_cache )
+            {
+                fitness_cache->addFitness( genotype_hash, configuration_hash, fitScore );
+            }
+
             return { species, fitScore, genotype };
         };
 
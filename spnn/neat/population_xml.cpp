@@ -135,6 +135,7 @@ namespace neat
         mutationRates(),
         mutatorFunctor( nullptr ),
         fitnessCalculatorFactory( fitFactory ),
+        fitnessCache( nullptr ),
         generationDataToKeep( ~0L ),
         generationLog(),
         minSpeciesSize( ~0L ),
@@ -2,6 +2,7 @@
 #define RANDOM_FUNCTOR_HPP_INCLUDED
 
 #include <algorithm>
+#include <cstdint>
 #include <random>
 #include <mutex>
 
@@ -107,6 +108,101 @@ namespace Rand
                 return std::uniform_int_distribution<uintmax_t>( min, max )( generator );
             }
     };
+
+    // counter based generator (Philox4x32-10), every number is a function of the seed, the stream and how many numbers came before it in the stream.
+    // a stream is picked by three ids (each truncated to 32 bits), so work split across threads can take a stream per item instead of sharing a locked generator,
+    // and draws the same numbers no matter which thread runs it or in what order. it is as cheap to make as it is to copy, and is not safe to share between threads.
+    class Random_Counter : public RandomFunctor
+    {
+        private:
+            uint32_t key[2];
+            uint32_t counter[4]; // the block index, then the three stream ids
+            uint32_t block[4];
+            size_t blockUsed; // 64 bit halves of block already handed out
+
+        public:
+            Random_Counter( uintmax_t _seed, uint64_t generation = 0, uint64_t individual = 0, uint64_t purpose = 0 )
+            : key{ uint32_t( _seed ), uint32_t( uint64_t( _seed ) >> 32 ) }, counter{ 0, uint32_t( purpose ), uint32_t( individual ), uint32_t( generation ) }, block{ 0, 0, 0, 0 }, blockUsed( 2 )
+            {
+
+            }
+
+            virtual ~Random_Counter() = default;
+
+            inline
+            long double
+            Float( long double min = 0.0, long double max = 1.0 ) override
+            {
+                // the top 53 bits, so that every value is equally likely and exact in a double
+                return min + ( max - min ) * ( (long double)( Next() >> 11 ) / 9007199254740992.0L );
+            }
+
+            inline
+            uintmax_t
+            Int( uintmax_t min = 0, uintmax_t max = ~1 ) override
+            {
+                uintmax_t range = max - min;
+
+                if( range == ~uintmax_t( 0 ) )
+                {
+                    return Next();
+                }
+
+                // reject the low values that would make some results more likely than others
+                uintmax_t bound = range + 1;
+                uintmax_t threshold = ( uintmax_t( 0 ) - bound ) % bound;
+                uintmax_t value;
+
+                do
+                {
+                    value = Next();
+                }
+                while( value < threshold );
+
+                return min + value % bound;
+            }
+
+            inline
+            uint64_t
+            Next()
+            {
+                if( blockUsed == 2 )
+                {
+                    Philox( counter, key, block );
+                    ++counter[0];
+                    blockUsed = 0;
+                }
+
+                uint64_t out = ( uint64_t( block[ blockUsed * 2 + 1 ] ) << 32 ) | block[ blockUsed * 2 ];
+                ++blockUsed;
+                return out;
+            }
+
+            // the Philox4x32 bijection with 10 rounds, from "Parallel Random Numbers: As Easy as 1, 2, 3" (Salmon et al. 2011)
+            static inline
+            void
+            Philox( const uint32_t (&in)[4], const uint32_t (&inKey)[2], uint32_t (&out)[4] )
+            {
+                uint32_t c0 = in[0], c1 = in[1], c2 = in[2], c3 = in[3];
+                uint32_t k0 = inKey[0], k1 = inKey[1];
+
+                for( size_t round = 0; round < 10; ++round )
+                {
+                    uint64_t product0 = uint64_t( 0xD2511F53 ) * c0;
+                    uint64_t product1 = uint64_t( 0xCD9E8D57 ) * c2;
+
+                    c0 = uint32_t( product1 >> 32 ) ^ c1 ^ k0;
+                    c1 = uint32_t( product1 );
+                    c2 = uint32_t( product0 >> 32 ) ^ c3 ^ k1;
+                    c3 = uint32_t( product0 );
+
+                    k0 += 0x9E3779B9;
+                    k1 += 0xBB67AE85;
+                }
+
+                out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+            }
+    };
 }
 
 #include "random_functor.inl"
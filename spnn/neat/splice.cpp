@@ -1,136 +1,123 @@
-
-#include <map>
-#include <set>
+#include <algorithm>
+#include <vector>
 
 #include "splice.hpp"
 
 namespace neat
 {
-    NetworkGenotype
-    SpliceGenotypes( const NetworkGenotype& parent1, const NetworkGenotype& parent2, std::shared_ptr< Rand::RandomFunctor > rand )
+    namespace
     {
-        return SpliceGenotypes( { &parent1, &parent2 }, rand );
-    }
+        // the id that genes line up by across genotypes, innovationID for connections and NodeID for nodes
 
-    NetworkGenotype
-    SpliceGenotypes( const std::vector< const NetworkGenotype* >& genotypes, std::shared_ptr< Rand::RandomFunctor > rand )
-    {
-        // data we need to gather about each genotype given
-        struct genotype_data
-        {
-            const NetworkGenotype *                         genotype_ptr;
-            std::map< NodeID, const NodeDef * >             node_map;
-            std::map< InnovationID, const ConnectionDef * > innov_map;
-            InnovationID                                    max_innov_id;
-
-            // boilerplate for the struct
-            genotype_data() : genotype_ptr( nullptr ), node_map(), innov_map(), max_innov_id( 0 ) { }
-            genotype_data( const genotype_data& ) = default; // TODO(dot##1/7/2019): should these actually be default?
-            genotype_data& operator=( const genotype_data& ) = default; // TODO(dot##1/7/2019): should these actually be default?
-
-            // constructor to extract the information from the given genotype pointer
-            genotype_data( const NetworkGenotype * genotype, std::set< NodeID >& all_node_ids, std::set< InnovationID >& all_innov_ids )
-                 : genotype_ptr( genotype ), node_map(), innov_map(), max_innov_id( 0 )
-            {
-                // go through the nodes in the genotype
-                for( const auto& node : genotype_ptr->nodeGenotype )
-                {
-                    // add the node id to the total set of node ids
-                    all_node_ids.emplace( node.ID );
+        inline InnovationID GeneKey( const ConnectionDef& connection ) { return connection.innovation; }
+        inline NodeID GeneKey( const NodeDef& node ) { return node.ID; }
 
-                    // map the node id to the actual node def
-                    node_map.emplace( node.ID, &node );
-                }
-
-                // go through the connections in the genotype
-                for( const auto& conn : genotype_ptr->connectionGenotype )
-                {
-                    // add the innovation id to the  total set of innovation ids
-                    all_innov_ids.emplace( conn.innovation );
+        // pointers to the genes of a genotype in id order, keeping only the first gene of an id that shows up more than once
+        template< typename GeneType >
+        std::vector< const GeneType * >
+        GenesByKey( const GeneList< GeneType >& genes )
+        {
+            std::vector< const GeneType * > out;
+            out.reserve( genes.size() );
 
-                    // map the connection to the id in the extra data
-                    innov_map.emplace( conn.innovation, &conn );
+            bool sorted = true;
 
-                    // track the max innovation id for excess finding
-                    max_innov_id = std::max( max_innov_id, conn.innovation );
-                }
+            for( const GeneType& gene : genes )
+            {
+                sorted = sorted && ( out.empty() || GeneKey( *out.back() ) < GeneKey( gene ) );
+                out.emplace_back( &gene );
             }
-        };
-
-        // make sure we have a functioning random number generator
-        if( !rand ) rand = std::make_shared< Rand::Random_Safe >( Rand::Int() );
-
-        // the total sets of all the given nodeID's and innovationID's
-        std::set< NodeID >       all_node_ids;
-        std::set< InnovationID > all_innov_ids;
-        InnovationID             all_max_innov_id = 0;
-
-        // list of genotype extracted data
-        std::vector< genotype_data > genenotype_extra_data;
-
-        // extract the data for each genotype
-        for( const NetworkGenotype * genotype : genotypes )
-        {
-            // pass the genotype pointer to the data struct, it will extract all the info, and add relevant stuff to all_node_ids and all_innov_ids
-            genotype_data data( genotype, all_node_ids, all_innov_ids );
 
-            // get the total max innovation id
-            all_max_innov_id = std::max( all_max_innov_id, data.max_innov_id );
+            // genotypes keep their genes in the order they were made, which is almost always id order already
+            if( !sorted )
+            {
+                std::stable_sort( out.begin(), out.end(), []( const GeneType * a, const GeneType * b ){ return GeneKey( *a ) < GeneKey( *b ); } );
+                out.erase( std::unique( out.begin(), out.end(), []( const GeneType * a, const GeneType * b ){ return GeneKey( *a ) == GeneKey( *b ); } ), out.end() );
+            }
 
-            // add the extracted genotype data to the list of extracted genotype data structs
-            genenotype_extra_data.push_back( data );
+            return out;
         }
 
-        NetworkGenotype output;
-
-        // construct the genotype
+        // walk the genes of every parent in id order together, and for each id any of them have, add the gene of a randomly selected parent that has it
+        template< typename GeneType >
+        void
+        SpliceGenes( const std::vector< std::vector< const GeneType * > >& parentGenes, GeneList< GeneType >& output, Rand::RandomFunctor& rand )
         {
-            // add a node for each present NodeID, randomly selected from the input genotypes that have said NodeID
-            for( NodeID id : all_node_ids )
+            std::vector< size_t > positions( parentGenes.size(), 0 );
+            std::vector< const GeneType * > available_genes;
+            available_genes.reserve( parentGenes.size() );
+
+            while( true )
             {
-                std::vector< const NodeDef * > available_nodes;
+                // find the lowest id that has not been added yet
+                const GeneType * lowest = nullptr;
 
-                for( const auto& gdata : genenotype_extra_data )
+                for( size_t p = 0; p < parentGenes.size(); ++p )
                 {
-                    auto it = gdata.node_map.find( id );
-                    if( it != gdata.node_map.end() && it->second != nullptr )
+                    if( positions[ p ] < parentGenes[ p ].size() )
                     {
-                        available_nodes.push_back( it->second );
+                        const GeneType * gene = parentGenes[ p ][ positions[ p ] ];
+
+                        if( !lowest || GeneKey( *gene ) < GeneKey( *lowest ) )
+                        {
+                            lowest = gene;
+                        }
                     }
                 }
 
-                if( available_nodes.empty() )
+                if( !lowest )
                 {
-                    // error
+                    break;
                 }
 
-                // add the randomly selected node to the output nodes
-                output.nodeGenotype.push_back( *available_nodes[ rand->Int( 0, available_nodes.size()-1 ) ] );
-            }
-
-            // repeat for the connections and InnovationID's
-            for( InnovationID id : all_innov_ids )
-            {
-                std::vector< const ConnectionDef * > available_conns;
+                // gather the genes with that id, in parent order, and step past them
+                available_genes.clear();
 
-                for( const auto& gdata : genenotype_extra_data )
+                for( size_t p = 0; p < parentGenes.size(); ++p )
                 {
-                    auto it = gdata.innov_map.find( id );
-                    if( it != gdata.innov_map.end() && it->second != nullptr )
+                    if( positions[ p ] < parentGenes[ p ].size() && GeneKey( *parentGenes[ p ][ positions[ p ] ] ) == GeneKey( *lowest ) )
                     {
-                        available_conns.push_back( it->second );
+                        available_genes.push_back( parentGenes[ p ][ positions[ p ] ] );
+                        ++positions[ p ];
                     }
                 }
 
-                if( available_conns.empty() )
-                {
-                    // error
-                }
-
-                // add the randomly selected connection to the output connections
-                output.connectionGenotype.push_back( *available_conns[ rand->Int( 0, available_conns.size()-1 ) ] );
+                // add the randomly selected gene to the output genes
+                output.push_back( *available_genes[ rand.Int( 0, available_genes.size()-1 ) ] );
             }
         }
+    }
+
+    NetworkGenotype
+    SpliceGenotypes( const NetworkGenotype& parent1, const NetworkGenotype& parent2, std::shared_ptr< Rand::RandomFunctor > rand )
+    {
+        return SpliceGenotypes( { &parent1, &parent2 }, rand );
+    }
+
+    NetworkGenotype
+    SpliceGenotypes( const std::vector< const NetworkGenotype* >& genotypes, std::shared_ptr< Rand::RandomFunctor > rand )
+    {
+        // make sure we have a functioning random number generator
+        if( !rand ) rand = std::make_shared< Rand::Random_Counter >( Rand::Int() );
+
+        // the genes of each genotype given, in id order
+        std::vector< std::vector< const NodeDef * > >       parent_nodes;
+        std::vector< std::vector< const ConnectionDef * > > parent_conns;
+
+        parent_nodes.reserve( genotypes.size() );
+        parent_conns.reserve( genotypes.size() );
+
+        for( const NetworkGenotype * genotype : genotypes )
+        {
+            parent_nodes.push_back( GenesByKey( genotype->nodeGenotype ) );
+            parent_conns.push_back( GenesByKey( genotype->connectionGenotype ) );
+        }
+
+        NetworkGenotype output;
+
+        // construct the genotype, a node for each present NodeID, then a connection for each present InnovationID, each randomly selected from the input genotypes that have it
+        SpliceGenes( parent_nodes, output.nodeGenotype, *rand );
+        SpliceGenes( parent_conns, output.connectionGenotype, *rand );
 
         return output;
     }
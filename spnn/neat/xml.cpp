@@ -171,22 +171,22 @@ namespace neat
             nodes_node->append_attribute( Attribute( "N", xml::to_string( genotype.getNumNodes() ), mem_pool ) );
             if( data_blob != nullptr )
             {
-                data_blob->add_data( genotype.getNodes() ).SaveToXML_asAttributes( nodes_node, mem_pool );
+                data_blob->add_data( genotype.getNodes().to_vector() ).SaveToXML_asAttributes( nodes_node, mem_pool );
             }
             else
             {
-                nodes_node->append_attribute( Attribute( "data", b64::Encode_NodeGenotype( genotype.getNodes() ), mem_pool ) );
+                nodes_node->append_attribute( Attribute( "data", b64::Encode_NodeGenotype( genotype.getNodes().to_vector() ), mem_pool ) );
             }
             genotype_node->append_node( nodes_node );
 
             conns_node->append_attribute( Attribute( "N", xml::to_string( genotype.getNumConnections() ), mem_pool ) );
             if( data_blob != nullptr )
             {
-                data_blob->add_data( genotype.getConnections() ).SaveToXML_asAttributes( conns_node, mem_pool );
+                data_blob->add_data( genotype.getConnections().to_vector() ).SaveToXML_asAttributes( conns_node, mem_pool );
             }
             else
             {
-                conns_node->append_attribute( Attribute( "data", b64::Encode_ConnectionGenotype( genotype.getConnections() ), mem_pool ) );
+                conns_node->append_attribute( Attribute( "data", b64::Encode_ConnectionGenotype( genotype.getConnections().to_vector() ), mem_pool ) );
             }
             genotype_node->append_node( conns_node );
 
@@ -0,0 +1,238 @@
+#ifndef SPNN_COMPILED_NETWORK_HPP_INCLUDED
+#define SPNN_COMPILED_NETWORK_HPP_INCLUDED
+
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <limits>
+
+namespace spnn
+{
+    template < typename Type, typename TimeType > class compiled_network_base;
+}
+
+#include "pulse_manager_wheel.hpp"
+
+namespace spnn
+{
+    // structure-of-arrays network, behaves exactly like a network_base filled with neuron_base's
+    //   neuron parameters and state live in parallel arrays indexed by neuron index
+    //   synapses live in one CSR block, the synapses of neuron i are [ synapseOffsets[i], synapseOffsets[i+1] )
+    //   neurons and synapses are added first, Finalize() builds the CSR block, after that only the state changes
+    //   in event driven mode ( setEventDriven ) a neuron is only touched when a pulse arrives or when it is due to activate or go to sleep,
+    //     the quiet ticks in between are applied lazily, spike timing and statistics are the same as ticking every neuron every step
+    //     a falling value is brought down a whole binade at a time, so the cost follows the pulses and activations, not the ticks
+    //   the input port ( setInputNeurons, setInputValues ) moves input neurons to target values at the next Tick without going through the pulse queue
+
+    template < typename Type, typename TimeType >
+    class compiled_network_base
+    {
+        public:
+
+            // types
+
+            typedef uint32_t index_type;
+            typedef uint32_t length_type;
+
+            struct pulse
+            {
+                TimeType time;
+                Type value;
+                index_type destination;
+            };
+
+            class neuron_view
+            {
+                private:
+
+                    const compiled_network_base< Type, TimeType > * network;
+                    index_type index;
+
+                public:
+
+                    neuron_view( const compiled_network_base< Type, TimeType > * net, index_type i );
+
+                    // getters, same as neuron_base
+
+                    uint64_t     getID() const;
+                    Type         getValue() const;
+                    TimeType     getRefractoryCount() const;
+                    bool         getIsActive() const;
+                    uint64_t     getNumActivations() const;
+                    size_t       getNumSynapses() const;
+                    long double  getCurrentActivationPercent() const;
+            };
+
+            typedef std::function< void( const neuron_view& ) > callback_type;
+
+        private:
+
+            // tracking
+
+            uint64_t pulsesProcessed;
+            uint64_t neuronsProcessed;
+            uint64_t inputsProcessed;
+
+            uint64_t pulsesProcessedLastTick;
+            uint64_t neuronsProcessedLastTick;
+
+            // behavior variables
+
+            TimeType deltaTime;
+
+        protected:
+
+            // neuron parameters
+
+            std::vector< Type >          thresholdMin;
+            std::vector< Type >          thresholdMax;
+            std::vector< TimeType >      refractoryTimeHigh; // high frequency ( smaller number )
+            std::vector< TimeType >      refractoryTimeLow;  // low frequency ( larger number )
+            std::vector< Type >          valueDecay;
+            std::vector< Type >          activationDecay;
+
+            std::vector< callback_type > onActivationFuncs;
+
+            // neuron state
+
+            std::vector< Type >          neuronValues;
+            std::vector< TimeType >      refractoryCounts;
+            std::vector< TimeType >      refractoryCountsForLastActivation;
+            std::vector< uint64_t >      numActivations;
+
+            // synapses, CSR
+
+            std::vector< index_type >    synapseOffsets;
+            std::vector< index_type >    synapseDestinations;
+            std::vector< length_type >   synapseLengths;
+            std::vector< Type >          synapseWeights;
+
+            std::vector< index_type >    synapseSources; // only used before Finalize()
+
+            // state
+
+            pulseManager_wheel_base< Type, TimeType, pulse > pulses;
+
+            TimeType currentTime;
+
+            bool finalized;
+
+            // input port
+
+            std::vector< index_type >    inputPortNeurons;
+            std::vector< Type >          inputPortDeltas;    // target value minus the value when the target was set
+
+            bool inputPortPending;
+
+            // event driven state, see setEventDriven()
+
+            std::vector< TimeType >      neuronTimes;          // first tick not yet applied to each neuron
+            std::vector< TimeType >      neuronWakeTimes;      // tick each neuron has to be processed at if no pulse arrives first, or noWakeTime
+            std::vector< Type >          wakeValues;           // the state each neuron will be in at its wake time
+            std::vector< TimeType >      wakeRefractoryCounts;
+            std::vector< uint8_t >       neuronFlags;          // touchedFlag | awakeFlag
+
+            std::vector< index_type >    touchedNeurons;
+
+            pulseManager_wheel_base< Type, TimeType, pulse > wakes;
+
+            size_t awakeNeurons; // neurons sitting in a run of quiet ticks, each one counts as processed every tick
+            TimeType quietHorizon; // the most quiet ticks worked out ahead at once, a neuron that never goes to sleep is woken this often
+
+            bool eventDriven;
+
+            static constexpr TimeType noWakeTime = std::numeric_limits< TimeType >::max();
+            static constexpr uint8_t touchedFlag = 1;
+            static constexpr uint8_t awakeFlag = 2;
+
+        public:
+
+            // constructors
+
+            compiled_network_base( const TimeType& dTime );
+
+            // destructor
+
+            virtual ~compiled_network_base();
+
+            // construction
+
+            index_type AddNeuron( const Type& t_min, const Type& t_max, const TimeType& rt_high, const TimeType& rt_low, const Type& vdec, const Type& adec );
+            size_t AddSynapse( index_type source, index_type destination, const TimeType& length, const Type& weight );
+
+            void Finalize();
+
+            // methods
+
+            void Tick();
+            void TickUntil( const TimeType& time );
+
+            size_t QueuePulse( index_type destination, const TimeType& time, const Type& value );
+
+            bool Verify() const;
+
+            void clear_network_state();
+
+            // setters
+
+            void setCallbackFunction( index_type neuron, callback_type func = nullptr );
+            void setEventDriven( bool event_driven );
+
+            void setInputNeurons( const std::vector< index_type >& neurons );
+
+            template < typename InputType >
+            bool setInputValues( const InputType * values, size_t count );
+
+            // properties
+
+            TimeType Time() const;
+            TimeType DeltaTime() const;
+            size_t QueueSize() const;
+
+            uint64_t PulsesProcessed() const;
+            uint64_t NeuronsProcessed() const;
+            uint64_t InputsProcessed() const; // input port values applied, each one stands in for an input pulse, which PulsesProcessed would have counted
+
+            uint64_t PulsesProcessedLastTick() const;
+            uint64_t NeuronsProcessedLastTick() const;
+
+            size_t NumNeurons() const;
+            size_t NumSynapses() const;
+            bool   IsFinalized() const;
+            bool   IsEventDriven() const;
+            size_t NumInputs() const;
+
+            neuron_view Neuron( index_type neuron ) const;
+
+        protected:
+
+            // methods
+
+            bool TickNeuron( index_type neuron );
+
+            void applyInputs();
+            void tickAll();
+            void tickEvents();
+            void touchNeuron( index_type neuron );
+            void catchUpNeuron( index_type neuron, const TimeType& time );
+            void scheduleNeuron( index_type neuron );
+
+            TimeType quietTicks( index_type neuron, Type& value, TimeType& refractoryCount, TimeType max_ticks ) const;
+            static TimeType sameStepTicks( const Type& value, const Type& decay, TimeType max_ticks, Type& step );
+            TimeType nextEventTime( const TimeType& limit ) const;
+
+            // getters
+
+            void currentState( index_type neuron, Type& value, TimeType& refractoryCount ) const;
+
+            long double currentActivationPercent( index_type neuron ) const;
+            TimeType currentRefractoryIfActivated( index_type neuron ) const;
+
+            long double activationPercent( index_type neuron, const Type& value ) const;
+            TimeType refractoryIfActivated( index_type neuron, const Type& value ) const;
+    };
+}
+
+#include "compiled_network.inl"
+
+#endif // SPNN_COMPILED_NETWORK_HPP_INCLUDED
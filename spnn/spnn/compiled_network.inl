@@ -0,0 +1,1104 @@
+#ifndef COMPILED_NETWORK_INL_INCLUDED
+#define COMPILED_NETWORK_INL_INCLUDED
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+namespace spnn
+{
+    // neuron_view
+
+    template < typename Type, typename TimeType >
+    compiled_network_base< Type, TimeType >::neuron_view::neuron_view( const compiled_network_base< Type, TimeType > * net, index_type i )
+         : network( net ), index( i )
+    {
+        assert( network && index < network->NumNeurons() );
+    }
+
+    template < typename Type, typename TimeType >
+    uint64_t
+    compiled_network_base< Type, TimeType >::neuron_view::getID() const
+    {
+        return index;
+    }
+
+    template < typename Type, typename TimeType >
+    Type
+    compiled_network_base< Type, TimeType >::neuron_view::getValue() const
+    {
+        Type value;
+        TimeType refractoryCount;
+
+        network->currentState( index, value, refractoryCount );
+
+        return value;
+    }
+
+    template < typename Type, typename TimeType >
+    TimeType
+    compiled_network_base< Type, TimeType >::neuron_view::getRefractoryCount() const
+    {
+        Type value;
+        TimeType refractoryCount;
+
+        network->currentState( index, value, refractoryCount );
+
+        return refractoryCount;
+    }
+
+    template < typename Type, typename TimeType >
+    bool
+    compiled_network_base< Type, TimeType >::neuron_view::getIsActive() const
+    {
+        return ( getValue() >= network->thresholdMin[ index ] );
+    }
+
+    template < typename Type, typename TimeType >
+    uint64_t
+    compiled_network_base< Type, TimeType >::neuron_view::getNumActivations() const
+    {
+        return network->numActivations[ index ];
+    }
+
+    template < typename Type, typename TimeType >
+    size_t
+    compiled_network_base< Type, TimeType >::neuron_view::getNumSynapses() const
+    {
+        if( network->finalized )
+        {
+            return network->synapseOffsets[ index + 1 ] - network->synapseOffsets[ index ];
+        }
+
+        return std::count( network->synapseSources.begin(), network->synapseSources.end(), index );
+    }
+
+    template < typename Type, typename TimeType >
+    long double
+    compiled_network_base< Type, TimeType >::neuron_view::getCurrentActivationPercent() const
+    {
+        return network->currentActivationPercent( index );
+    }
+
+
+    // compiled_network_base
+
+    // constants
+
+    template < typename Type, typename TimeType >
+    constexpr TimeType compiled_network_base< Type, TimeType >::noWakeTime;
+
+    template < typename Type, typename TimeType >
+    constexpr uint8_t compiled_network_base< Type, TimeType >::touchedFlag;
+
+    template < typename Type, typename TimeType >
+    constexpr uint8_t compiled_network_base< Type, TimeType >::awakeFlag;
+
+    // constructors
+
+    template < typename Type, typename TimeType >
+    compiled_network_base< Type, TimeType >::compiled_network_base( const TimeType& dTime )
+         : pulsesProcessed( 0 ), neuronsProcessed( 0 ), inputsProcessed( 0 ), pulsesProcessedLastTick( 0 ), neuronsProcessedLastTick( 0 ), deltaTime( dTime ),
+           thresholdMin(), thresholdMax(), refractoryTimeHigh(), refractoryTimeLow(), valueDecay(), activationDecay(), onActivationFuncs(),
+           neuronValues(), refractoryCounts(), refractoryCountsForLastActivation(), numActivations(),
+           synapseOffsets(), synapseDestinations(), synapseLengths(), synapseWeights(), synapseSources(),
+           pulses(), currentTime( 0 ), finalized( false ), inputPortNeurons(), inputPortDeltas(), inputPortPending( false ),
+           neuronTimes(), neuronWakeTimes(), wakeValues(), wakeRefractoryCounts(), neuronFlags(), touchedNeurons(), wakes(), awakeNeurons( 0 ), quietHorizon( 4096 ), eventDriven( false )
+    {
+        assert( DeltaTime() > 0 );
+    }
+
+    // destructor
+
+    template < typename Type, typename TimeType >
+    compiled_network_base< Type, TimeType >::~compiled_network_base()
+    {
+        /*  */
+    }
+
+    // construction
+
+    template < typename Type, typename TimeType >
+    typename compiled_network_base< Type, TimeType >::index_type
+    compiled_network_base< Type, TimeType >::AddNeuron( const Type& t_min, const Type& t_max, const TimeType& rt_high, const TimeType& rt_low, const Type& vdec, const Type& adec )
+    {
+        assert( !finalized && "Cannot add neurons to a finalized compiled_network_base." );
+        assert( t_max >= t_min && "Neuron cannot Tick with reverse threshold min/max." );
+        assert( rt_low >= rt_high && "Neuron cannot Tick with reverse refractory times min/max." );
+        assert( NumNeurons() < std::numeric_limits< index_type >::max() );
+
+        thresholdMin.push_back( t_min );
+        thresholdMax.push_back( t_max );
+        refractoryTimeHigh.push_back( rt_high );
+        refractoryTimeLow.push_back( rt_low );
+        valueDecay.push_back( vdec );
+        activationDecay.push_back( adec );
+
+        onActivationFuncs.emplace_back();
+
+        neuronValues.push_back( 0 );
+        refractoryCounts.push_back( 0 );
+        refractoryCountsForLastActivation.push_back( 0 );
+        numActivations.push_back( 0 );
+
+        neuronTimes.push_back( currentTime );
+        neuronWakeTimes.push_back( noWakeTime );
+        wakeValues.push_back( 0 );
+        wakeRefractoryCounts.push_back( 0 );
+        neuronFlags.push_back( 0 );
+
+        return index_type( NumNeurons() - 1 );
+    }
+
+    template < typename Type, typename TimeType >
+    size_t
+    compiled_network_base< Type, TimeType >::AddSynapse( index_type source, index_type destination, const TimeType& length, const Type& weight )
+    {
+        assert( !finalized && "Cannot add synapses to a finalized compiled_network_base." );
+        assert( length <= std::numeric_limits< length_type >::max() && "Synapse length does not fit in length_type." );
+
+        // null safety, both ends must exist
+        if( source >= NumNeurons() || destination >= NumNeurons() )
+        {
+            return 0;
+        }
+
+        synapseSources.push_back( source );
+        synapseDestinations.push_back( destination );
+        synapseLengths.push_back( length_type( length ) );
+        synapseWeights.push_back( weight );
+
+        return NumSynapses();
+    }
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::Finalize()
+    {
+        assert( !finalized );
+
+        // counting sort the synapses by source, keeping the order they were added in for each source
+        synapseOffsets.assign( NumNeurons() + 1, 0 );
+
+        for( auto source : synapseSources )
+        {
+            ++synapseOffsets[ source + 1 ];
+        }
+
+        for( size_t i = 1; i < synapseOffsets.size(); ++i )
+        {
+            synapseOffsets[ i ] += synapseOffsets[ i - 1 ];
+        }
+
+        std::vector< index_type >  destinations( NumSynapses() );
+        std::vector< length_type > lengths( NumSynapses() );
+        std::vector< Type >        weights( NumSynapses() );
+
+        {
+            std::vector< index_type > next( synapseOffsets.begin(), synapseOffsets.end() - 1 );
+
+            for( size_t i = 0; i < synapseSources.size(); ++i )
+            {
+                index_type slot = next[ synapseSources[ i ] ]++;
+
+                destinations[ slot ] = synapseDestinations[ i ];
+                lengths[ slot ]      = synapseLengths[ i ];
+                weights[ slot ]      = synapseWeights[ i ];
+            }
+        }
+
+        synapseDestinations.swap( destinations );
+        synapseLengths.swap( lengths );
+        synapseWeights.swap( weights );
+
+        // the sources are implied by the offsets now
+        synapseSources.clear();
+        synapseSources.shrink_to_fit();
+
+        finalized = true;
+
+        assert( Verify() && "the network must only contain synapses to neurons that are in the network." );
+    }
+
+    // methods
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::Tick()
+    {
+        assert( finalized && "compiled_network_base must be finalized before it can Tick." );
+
+        pulsesProcessedLastTick = 0;
+        neuronsProcessedLastTick = 0;
+
+        // inputs land before any pulse of this tick
+        if( inputPortPending )
+        {
+            applyInputs();
+        }
+
+        if( eventDriven )
+        {
+            tickEvents();
+        }
+        else
+        {
+            tickAll();
+        }
+
+        pulsesProcessed += pulsesProcessedLastTick;
+        neuronsProcessed += neuronsProcessedLastTick;
+
+        // increment the time
+        currentTime += deltaTime;
+    }
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::TickUntil( const TimeType& time )
+    {
+        while( currentTime < time )
+        {
+            if( eventDriven )
+            {
+                TimeType next = nextEventTime( time );
+
+                // nothing arrives and nobody activates before next, so skip straight to it
+                if( next > currentTime )
+                {
+                    TimeType ticks = ( next - currentTime ) / deltaTime;
+
+                    pulsesProcessedLastTick = 0;
+                    neuronsProcessedLastTick = awakeNeurons;
+
+                    neuronsProcessed += uint64_t( awakeNeurons ) * uint64_t( ticks );
+
+                    currentTime = next;
+
+                    continue;
+                }
+            }
+
+            Tick();
+        }
+    }
+
+    template < typename Type, typename TimeType >
+    size_t
+    compiled_network_base< Type, TimeType >::QueuePulse( index_type destination, const TimeType& time, const Type& value )
+    {
+        // don't queue pulses without destinations
+        if( destination >= NumNeurons() )
+        {
+            return 0;
+        }
+
+        return pulses.QueuePulse( pulse{ time, value, destination } );
+    }
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::applyInputs()
+    {
+        for( size_t i = 0; i < inputPortNeurons.size(); ++i )
+        {
+            index_type neuron = inputPortNeurons[ i ];
+
+            if( eventDriven )
+            {
+                touchNeuron( neuron );
+            }
+
+            neuronValues[ neuron ] += inputPortDeltas[ i ];
+        }
+
+        inputsProcessed += inputPortNeurons.size();
+
+        inputPortPending = false;
+    }
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::tickAll()
+    {
+        // transmit the pulses to their destinations
+        {
+            Type * value_data = neuronValues.data();
+            uint64_t processed = 0;
+
+            pulses.ProcessCurrentTimePulses( currentTime, [value_data,&processed]( const pulse& p )
+            {
+                value_data[ p.destination ] += p.value;
+                ++processed;
+            } );
+
+            pulsesProcessedLastTick = processed;
+        }
+
+        // process the neurons
+        {
+            const index_type num_neurons = index_type( NumNeurons() );
+
+            Type * value_data = neuronValues.data();
+            const TimeType * refractory_data = refractoryCounts.data();
+
+            for( index_type neuron = 0; neuron < num_neurons; ++neuron )
+            {
+                // sleepy neurons are the common case, handle them here the same way TickNeuron would
+                if( !( value_data[ neuron ] > 0 ) && !( refractory_data[ neuron ] > 0 ) )
+                {
+                    if( value_data[ neuron ] < 0 )
+                    {
+                        value_data[ neuron ] = 0;
+                    }
+                    continue;
+                }
+
+                if( TickNeuron( neuron ) )
+                {
+                    ++neuronsProcessedLastTick;
+                }
+            }
+        }
+    }
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::tickEvents()
+    {
+        // transmit the pulses to their destinations, each destination is brought up to date before its first pulse
+        {
+            uint64_t processed = 0;
+
+            pulses.ProcessCurrentTimePulses( currentTime, [this,&processed]( const pulse& p )
+            {
+                touchNeuron( p.destination );
+                neuronValues[ p.destination ] += p.value;
+                ++processed;
+            } );
+
+            pulsesProcessedLastTick = processed;
+        }
+
+        // the neurons that are due to activate or go to sleep, wakes replaced by an earlier pulse are stale
+        wakes.ProcessCurrentTimePulses( currentTime, [this]( const pulse& w )
+        {
+            if( neuronWakeTimes[ w.destination ] == w.time )
+            {
+                touchNeuron( w.destination );
+            }
+        }, false );
+
+        // the untouched awake neurons all have a quiet tick
+        neuronsProcessedLastTick = awakeNeurons;
+
+        // tick the touched neurons in index order, so callbacks happen in the same order as tickAll
+        //   once a good share of the network is touched, picking them out of the flags in order is cheaper than sorting
+        if( touchedNeurons.size() > NumNeurons() / 16 )
+        {
+            touchedNeurons.clear();
+
+            for( index_type neuron = 0; neuron < index_type( NumNeurons() ); ++neuron )
+            {
+                if( neuronFlags[ neuron ] & touchedFlag )
+                {
+                    touchedNeurons.push_back( neuron );
+                }
+            }
+        }
+        else
+        {
+            std::sort( touchedNeurons.begin(), touchedNeurons.end() );
+        }
+
+        for( auto neuron : touchedNeurons )
+        {
+            if( TickNeuron( neuron ) )
+            {
+                ++neuronsProcessedLastTick;
+            }
+
+            neuronTimes[ neuron ] = currentTime + deltaTime;
+
+            scheduleNeuron( neuron );
+        }
+
+        for( auto neuron : touchedNeurons )
+        {
+            neuronFlags[ neuron ] &= ~touchedFlag;
+        }
+
+        touchedNeurons.clear();
+    }
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::touchNeuron( index_type neuron )
+    {
+        if( neuronFlags[ neuron ] & touchedFlag )
+        {
+            return;
+        }
+
+        catchUpNeuron( neuron, currentTime );
+
+        // it gets a real tick now, so it no longer counts as quietly awake
+        if( neuronFlags[ neuron ] & awakeFlag )
+        {
+            --awakeNeurons;
+        }
+
+        neuronFlags[ neuron ] = touchedFlag;
+        touchedNeurons.push_back( neuron );
+    }
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::catchUpNeuron( index_type neuron, const TimeType& time )
+    {
+        if( neuronTimes[ neuron ] >= time )
+        {
+            return;
+        }
+
+        if( neuronWakeTimes[ neuron ] == time )
+        {
+            // already worked out when it was scheduled
+            neuronValues[ neuron ] = wakeValues[ neuron ];
+            refractoryCounts[ neuron ] = wakeRefractoryCounts[ neuron ];
+        }
+        else
+        {
+            TimeType ticks = ( time - neuronTimes[ neuron ] ) / deltaTime;
+            TimeType taken = quietTicks( neuron, neuronValues[ neuron ], refractoryCounts[ neuron ], ticks );
+
+            // only a sleepy neuron can stop short, an activation would have been its wake time
+            assert( taken == ticks || ( !( neuronValues[ neuron ] > 0 ) && !( refractoryCounts[ neuron ] > 0 ) ) );
+            (void)taken;
+        }
+
+        neuronTimes[ neuron ] = time;
+    }
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::scheduleNeuron( index_type neuron )
+    {
+        Type value = neuronValues[ neuron ];
+        TimeType refractoryCount = refractoryCounts[ neuron ];
+
+        TimeType ticks = quietTicks( neuron, value, refractoryCount, quietHorizon );
+
+        neuronFlags[ neuron ] &= ~awakeFlag;
+
+        // asleep right away, nothing to do until a pulse arrives
+        if( ticks == 0 && !( value > 0 ) && !( refractoryCount > 0 ) )
+        {
+            neuronWakeTimes[ neuron ] = noWakeTime;
+            return;
+        }
+
+        // wake up when it activates, falls asleep, or reaches the horizon
+        TimeType wake = neuronTimes[ neuron ] + ticks * deltaTime;
+
+        neuronWakeTimes[ neuron ] = wake;
+        wakeValues[ neuron ] = value;
+        wakeRefractoryCounts[ neuron ] = refractoryCount;
+
+        wakes.QueuePulse( pulse{ wake, Type( 0 ), neuron } );
+
+        if( ticks > 0 )
+        {
+            neuronFlags[ neuron ] |= awakeFlag;
+            ++awakeNeurons;
+        }
+    }
+
+    template < typename Type, typename TimeType >
+    TimeType
+    compiled_network_base< Type, TimeType >::sameStepTicks( const Type& value, const Type& decay, TimeType max_ticks, Type& step )
+    {
+        // value is a multiple of its binade's ulp, so while value - decay lands in the same binade, it always rounds off the same remainder of decay
+        //   and every such tick takes exactly the step the first one takes, up to max_ticks of them
+        //   0 when the first tick already leaves the binade, and for the cases the count cannot be exact for, which the caller steps through instead:
+        //   a long double that cannot hold value - decay exactly, a subnormal value, and a remainder of exactly half an ulp, which rounds to even
+
+        typedef long double wide_type;
+
+        if( std::numeric_limits< wide_type >::digits < 2 * std::numeric_limits< Type >::digits + 2 || !( value >= std::numeric_limits< Type >::min() ) || !( decay > 0 ) )
+        {
+            return 0;
+        }
+
+        int exponent = 0;
+        std::frexp( value, &exponent );
+
+        const Type low = std::ldexp( Type( 0.5 ), exponent );
+        const Type ulp = low * std::numeric_limits< Type >::epsilon();
+
+        // the rounding error of the first tick, exactly ( two-sum ), half an ulp is a tie
+        const Type first = value - decay;
+        const Type back = first - value;
+        const Type error = ( value - ( first - back ) ) + ( -decay - back );
+
+        if( std::abs( error ) * 2 == ulp )
+        {
+            return 0;
+        }
+
+        // the value - decay of tick k, counting from 0, has to stay at or above low
+        auto fits = [&]( TimeType k )
+        {
+            return wide_type( value ) - wide_type( k ) * wide_type( step ) - wide_type( decay ) >= wide_type( low );
+        };
+
+        step = value - first;
+
+        if( !fits( 0 ) )
+        {
+            return 0;
+        }
+
+        // decay is under half an ulp, the value never changes
+        if( step == 0 )
+        {
+            return max_ticks;
+        }
+
+        wide_type count = std::floor( ( wide_type( value ) - wide_type( decay ) - wide_type( low ) ) / wide_type( step ) ) + 1;
+
+        TimeType ticks = count < wide_type( max_ticks ) ? TimeType( count ) : max_ticks;
+
+        // the division can round across a whole number, settle it with the exact test
+        while( ticks > 0 && !fits( ticks - 1 ) )
+        {
+            --ticks;
+        }
+
+        while( ticks < max_ticks && fits( ticks ) )
+        {
+            ++ticks;
+        }
+
+        return ticks;
+    }
+
+    template < typename Type, typename TimeType >
+    TimeType
+    compiled_network_base< Type, TimeType >::quietTicks( index_type neuron, Type& value, TimeType& refractoryCount, TimeType max_ticks ) const
+    {
+        // applies up to max_ticks ticks of TickNeuron that do not activate, stops early before an activation or once asleep
+        //   n * valueDecay would not round the same as n subtractions, so a value below the threshold is brought down a binade at a time, see sameStepTicks
+        //   only a value at or above the threshold, waiting out its refractory count, is stepped one tick at a time
+
+        const Type t_min = thresholdMin[ neuron ];
+        const Type t_max = thresholdMax[ neuron ];
+        const Type v_decay = valueDecay[ neuron ];
+        const TimeType rt_low = refractoryTimeLow[ neuron ];
+        const TimeType rc_last = refractoryCountsForLastActivation[ neuron ];
+
+        TimeType taken = 0;
+
+        while( taken < max_ticks )
+        {
+            if( value < 0 )
+            {
+                value = 0;
+            }
+
+            // asleep, nothing changes until a pulse arrives
+            if( !( value > 0 ) && !( refractoryCount > 0 ) )
+            {
+                break;
+            }
+
+            // the value has bottomed out and cannot reach the threshold, only the refractory count runs down, in closed form
+            if( value == 0 && !( value >= t_min ) && v_decay >= 0 && refractoryCount <= rt_low && ( std::is_signed< TimeType >::value || refractoryCount % deltaTime == 0 ) )
+            {
+                TimeType ticks = std::min< TimeType >( ( refractoryCount + deltaTime - 1 ) / deltaTime, max_ticks - taken );
+
+                refractoryCount = ( ticks * deltaTime < refractoryCount ) ? TimeType( refractoryCount - ticks * deltaTime ) : TimeType( 0 );
+                taken += ticks;
+
+                continue;
+            }
+
+            // the value is below the threshold and falling towards zero, every tick it stays in its binade for takes the same step off
+            if( value > 0 && value < t_min && !( value > t_max ) && refractoryCount <= rt_low && ( std::is_signed< TimeType >::value || refractoryCount % deltaTime == 0 ) )
+            {
+                Type step = 0;
+                TimeType ticks = sameStepTicks( value, v_decay, max_ticks - taken, step );
+
+                if( ticks > 0 )
+                {
+                    value = Type( (long double)value - (long double)ticks * (long double)step );
+
+                    refractoryCount = ( ticks * deltaTime < refractoryCount ) ? TimeType( refractoryCount - ticks * deltaTime ) : TimeType( 0 );
+                    taken += ticks;
+
+                    continue;
+                }
+            }
+
+            TimeType rc = refractoryCount;
+
+            if( rc > 0 )
+            {
+                rc -= deltaTime;
+
+                if( rc < 0 )
+                {
+                    rc = 0;
+                }
+            }
+
+            // stop before a tick that activates
+            if( value >= t_min && ( !( rc > 0 ) || ( rc_last - rc > refractoryIfActivated( neuron, value ) ) ) )
+            {
+                break;
+            }
+
+            refractoryCount = rc;
+
+            value -= v_decay;
+
+            if( value < 0 )
+            {
+                value = 0;
+            }
+            else if( value > t_max )
+            {
+                value = t_max;
+            }
+
+            if( refractoryCount >= rt_low )
+            {
+                refractoryCount = rt_low;
+            }
+
+            ++taken;
+        }
+
+        return taken;
+    }
+
+    template < typename Type, typename TimeType >
+    TimeType
+    compiled_network_base< Type, TimeType >::nextEventTime( const TimeType& limit ) const
+    {
+        if( inputPortPending )
+        {
+            return currentTime;
+        }
+
+        TimeType next = std::min( pulses.NextPulseTime( limit ), wakes.NextPulseTime( limit ) );
+
+        if( next <= currentTime )
+        {
+            return currentTime;
+        }
+
+        // pulses between ticks are delivered on the following tick
+        return currentTime + ( ( next - currentTime + deltaTime - 1 ) / deltaTime ) * deltaTime;
+    }
+
+    template < typename Type, typename TimeType >
+    bool
+    compiled_network_base< Type, TimeType >::Verify() const
+    {
+        if( !finalized )
+        {
+            return false;
+        }
+
+        if( synapseOffsets.size() != NumNeurons() + 1 || synapseOffsets.back() != NumSynapses() || synapseLengths.size() != NumSynapses() || synapseWeights.size() != NumSynapses() )
+        {
+            return false;
+        }
+
+        if( !std::is_sorted( synapseOffsets.begin(), synapseOffsets.end() ) )
+        {
+            return false;
+        }
+
+        // every synapse must point to a neuron in the network
+        return std::all_of( synapseDestinations.begin(), synapseDestinations.end(), [this]( index_type destination ){ return destination < NumNeurons(); } );
+    }
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::clear_network_state()
+    {
+        pulsesProcessed = 0;
+        neuronsProcessed = 0;
+        inputsProcessed = 0;
+
+        pulsesProcessedLastTick = 0;
+        neuronsProcessedLastTick = 0;
+
+        currentTime = 0;
+
+        pulses.clear_all_pulses();
+
+        std::fill( neuronValues.begin(), neuronValues.end(), Type( 0 ) );
+        std::fill( refractoryCounts.begin(), refractoryCounts.end(), TimeType( 0 ) );
+        std::fill( refractoryCountsForLastActivation.begin(), refractoryCountsForLastActivation.end(), TimeType( 0 ) );
+        std::fill( numActivations.begin(), numActivations.end(), uint64_t( 0 ) );
+
+        wakes.clear_all_pulses();
+
+        std::fill( neuronTimes.begin(), neuronTimes.end(), TimeType( 0 ) );
+        std::fill( neuronWakeTimes.begin(), neuronWakeTimes.end(), noWakeTime );
+        std::fill( neuronFlags.begin(), neuronFlags.end(), uint8_t( 0 ) );
+
+        touchedNeurons.clear();
+        awakeNeurons = 0;
+
+        inputPortPending = false;
+    }
+
+    // setters
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::setCallbackFunction( index_type neuron, callback_type func )
+    {
+        assert( neuron < NumNeurons() );
+
+        onActivationFuncs[ neuron ] = func;
+    }
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::setEventDriven( bool event_driven )
+    {
+        if( event_driven == eventDriven )
+        {
+            return;
+        }
+
+        wakes.clear_all_pulses();
+        awakeNeurons = 0;
+
+        if( event_driven )
+        {
+            for( index_type neuron = 0; neuron < NumNeurons(); ++neuron )
+            {
+                neuronTimes[ neuron ] = currentTime;
+                neuronFlags[ neuron ] = 0;
+
+                scheduleNeuron( neuron );
+            }
+        }
+        else
+        {
+            // bring every neuron up to date, tickAll expects it
+            for( index_type neuron = 0; neuron < NumNeurons(); ++neuron )
+            {
+                catchUpNeuron( neuron, currentTime );
+
+                neuronWakeTimes[ neuron ] = noWakeTime;
+                neuronFlags[ neuron ] = 0;
+            }
+        }
+
+        eventDriven = event_driven;
+    }
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::setInputNeurons( const std::vector< index_type >& neurons )
+    {
+        assert( std::all_of( neurons.begin(), neurons.end(), [this]( index_type neuron ){ return neuron < NumNeurons(); } ) );
+
+        inputPortNeurons = neurons;
+        inputPortDeltas.assign( neurons.size(), Type( 0 ) );
+
+        inputPortPending = false;
+    }
+
+    template < typename Type, typename TimeType >
+    template < typename InputType >
+    bool
+    compiled_network_base< Type, TimeType >::setInputValues( const InputType * values, size_t count )
+    {
+        // need a value for every input neuron
+        if( !values || inputPortNeurons.empty() || count < inputPortNeurons.size() )
+        {
+            return false;
+        }
+
+        // same as a pulse of ( target - current value ), setting them again before the next Tick replaces the old targets
+        for( size_t i = 0; i < inputPortNeurons.size(); ++i )
+        {
+            Type value;
+            TimeType refractoryCount;
+
+            currentState( inputPortNeurons[ i ], value, refractoryCount );
+
+            inputPortDeltas[ i ] = Type( values[ i ] - value );
+        }
+
+        inputPortPending = true;
+
+        return true;
+    }
+
+    // properties
+
+    template < typename Type, typename TimeType >
+    TimeType
+    compiled_network_base< Type, TimeType >::Time() const
+    {
+        return currentTime;
+    }
+
+    template < typename Type, typename TimeType >
+    TimeType
+    compiled_network_base< Type, TimeType >::DeltaTime() const
+    {
+        return deltaTime;
+    }
+
+    template < typename Type, typename TimeType >
+    size_t
+    compiled_network_base< Type, TimeType >::QueueSize() const
+    {
+        return pulses.QueueSize();
+    }
+
+    template < typename Type, typename TimeType >
+    uint64_t
+    compiled_network_base< Type, TimeType >::PulsesProcessed() const
+    {
+        return pulsesProcessed;
+    }
+
+    template < typename Type, typename TimeType >
+    uint64_t
+    compiled_network_base< Type, TimeType >::NeuronsProcessed() const
+    {
+        return neuronsProcessed;
+    }
+
+    template < typename Type, typename TimeType >
+    uint64_t
+    compiled_network_base< Type, TimeType >::InputsProcessed() const
+    {
+        return inputsProcessed;
+    }
+
+    template < typename Type, typename TimeType >
+    uint64_t
+    compiled_network_base< Type, TimeType >::PulsesProcessedLastTick() const
+    {
+        return pulsesProcessedLastTick;
+    }
+
+    template < typename Type, typename TimeType >
+    uint64_t
+    compiled_network_base< Type, TimeType >::NeuronsProcessedLastTick() const
+    {
+        return neuronsProcessedLastTick;
+    }
+
+    template < typename Type, typename TimeType >
+    size_t
+    compiled_network_base< Type, TimeType >::NumNeurons() const
+    {
+        return neuronValues.size();
+    }
+
+    template < typename Type, typename TimeType >
+    size_t
+    compiled_network_base< Type, TimeType >::NumSynapses() const
+    {
+        return synapseDestinations.size();
+    }
+
+    template < typename Type, typename TimeType >
+    bool
+    compiled_network_base< Type, TimeType >::IsFinalized() const
+    {
+        return finalized;
+    }
+
+    template < typename Type, typename TimeType >
+    bool
+    compiled_network_base< Type, TimeType >::IsEventDriven() const
+    {
+        return eventDriven;
+    }
+
+    template < typename Type, typename TimeType >
+    size_t
+    compiled_network_base< Type, TimeType >::NumInputs() const
+    {
+        return inputPortNeurons.size();
+    }
+
+    template < typename Type, typename TimeType >
+    typename compiled_network_base< Type, TimeType >::neuron_view
+    compiled_network_base< Type, TimeType >::Neuron( index_type neuron ) const
+    {
+        return neuron_view( this, neuron );
+    }
+
+    // Tick Begin
+
+    template < typename Type, typename TimeType >
+    bool
+    compiled_network_base< Type, TimeType >::TickNeuron( index_type neuron )
+    {
+        // this is neuron_base::Tick over the parallel arrays, keep the two in lock step
+
+        Type& value = neuronValues[ neuron ];
+        TimeType& refractoryCount = refractoryCounts[ neuron ];
+        TimeType& refractoryCountForLastActivation = refractoryCountsForLastActivation[ neuron ];
+
+        // clamp so we have a sane value ( do not clamp max, it breaks things )
+        if( value < 0 )
+        {
+            value = 0;
+        }
+
+        // are we a sleepy neuron? if yes, then we don't need to continue
+        if( !( value > 0 ) && !( refractoryCount > 0 ) )
+        {
+            return false;
+        }
+
+        // if we have recently been activated;
+        if( refractoryCount > 0 )
+        {
+            // decrement time
+            refractoryCount -= deltaTime;
+
+            // ensure sanity
+            if( refractoryCount < 0 )
+            {
+                refractoryCount = 0;
+            }
+        }
+
+        TimeType rct = refractoryIfActivated( neuron, value );
+
+        // see neuron_base::Tick for the activation rules
+        if( value >= thresholdMin[ neuron ] && ( !( refractoryCount > 0 ) || ( refractoryCountForLastActivation - refractoryCount > rct ) ) )
+        {
+            // set refractory counts
+            refractoryCount = refractoryCountForLastActivation = rct;
+
+            // keep track
+            ++numActivations[ neuron ];
+
+            // subtract the activation decay, so that activation itself can slow down the pulse train
+            value -= activationDecay[ neuron ];
+
+            // tell other neurons what happened
+            for( index_type synapse = synapseOffsets[ neuron ], synapse_end = synapseOffsets[ neuron + 1 ]; synapse < synapse_end; ++synapse )
+            {
+                pulses.QueuePulse( pulse{ currentTime + synapseLengths[ synapse ], synapseWeights[ synapse ], synapseDestinations[ synapse ] } );
+            }
+
+            // call the callback
+            if( onActivationFuncs[ neuron ] )
+            {
+                onActivationFuncs[ neuron ]( neuron_view( this, neuron ) );
+            }
+        }
+
+        // decrement the value by the decay amount
+        value -= valueDecay[ neuron ];
+
+        // make sure we have a sane value, clamp value between 0 and threshold_max
+        if( value < 0 )
+        {
+            value = 0;
+        }
+        else if( value > thresholdMax[ neuron ] )
+        {
+            value = thresholdMax[ neuron ];
+        }
+
+        // make sure that the refractory count is upper bounded
+        if( refractoryCount >= refractoryTimeLow[ neuron ] )
+        {
+            refractoryCount = refractoryTimeLow[ neuron ];
+        }
+
+        return true;
+    }
+
+    // Tick End
+
+    // getters
+
+    template < typename Type, typename TimeType >
+    void
+    compiled_network_base< Type, TimeType >::currentState( index_type neuron, Type& value, TimeType& refractoryCount ) const
+    {
+        value = neuronValues[ neuron ];
+        refractoryCount = refractoryCounts[ neuron ];
+
+        // in event driven mode the stored state can lag behind, replay the quiet ticks without storing them
+        //   neurons not yet touched during a Tick read as of the start of that Tick
+        if( !eventDriven || ( neuronFlags[ neuron ] & touchedFlag ) || neuronTimes[ neuron ] >= currentTime )
+        {
+            return;
+        }
+
+        if( neuronWakeTimes[ neuron ] == currentTime )
+        {
+            value = wakeValues[ neuron ];
+            refractoryCount = wakeRefractoryCounts[ neuron ];
+            return;
+        }
+
+        quietTicks( neuron, value, refractoryCount, ( currentTime - neuronTimes[ neuron ] ) / deltaTime );
+    }
+
+    template < typename Type, typename TimeType >
+    long double
+    compiled_network_base< Type, TimeType >::currentActivationPercent( index_type neuron ) const
+    {
+        Type value;
+        TimeType refractoryCount;
+
+        currentState( neuron, value, refractoryCount );
+
+        return activationPercent( neuron, value );
+    }
+
+    template < typename Type, typename TimeType >
+    TimeType
+    compiled_network_base< Type, TimeType >::currentRefractoryIfActivated( index_type neuron ) const
+    {
+        Type value;
+        TimeType refractoryCount;
+
+        currentState( neuron, value, refractoryCount );
+
+        return refractoryIfActivated( neuron, value );
+    }
+
+    template < typename Type, typename TimeType >
+    long double
+    compiled_network_base< Type, TimeType >::activationPercent( index_type neuron, const Type& value ) const
+    {
+        long double rv = ( (long double)value - (long double)thresholdMin[ neuron ] ) / ( (long double)thresholdMax[ neuron ] - (long double)thresholdMin[ neuron ] );
+        return std::min( std::max( rv, 0.0L ), 1.0L );
+    }
+
+    template < typename Type, typename TimeType >
+    TimeType
+    compiled_network_base< Type, TimeType >::refractoryIfActivated( index_type neuron, const Type& value ) const
+    {
+        long double rel = activationPercent( neuron, value );
+        return ( refractoryTimeLow[ neuron ] * ( 1.0 - rel ) ) + ( refractoryTimeHigh[ neuron ] * rel );
+    }
+}
+
+#endif // COMPILED_NETWORK_INL_INCLUDED
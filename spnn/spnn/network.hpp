@@ -3,7 +3,7 @@
 
 namespace spnn
 {
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager = pulseManager_base< Type, TimeType > >
     class network_base
     {
         private:
@@ -28,7 +28,7 @@ namespace spnn
 
             // state
 
-            pulseManager_base< Type, TimeType > pulses;
+            PulseManager pulses;
 
             TimeType currentTime;
 
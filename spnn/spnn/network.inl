@@ -6,29 +6,29 @@
 
 namespace spnn
 {
-    template < typename Type, typename TimeType >
-    network_base< Type, TimeType >::network_base( const TimeType& dTime )
+    template < typename Type, typename TimeType, typename PulseManager >
+    network_base< Type, TimeType, PulseManager >::network_base( const TimeType& dTime )
         : pulsesProcessed( 0 ), neuronsProcessed( 0 ), pulsesProcessedLastTick( 0 ), neuronsProcessedLastTick( 0 ), deltaTime( dTime ), neurons(), pulses(), currentTime( 0 )
     {
         assert( DeltaTime() > 0 );
     }
 
-    template < typename Type, typename TimeType >
-    network_base< Type, TimeType >::~network_base()
+    template < typename Type, typename TimeType, typename PulseManager >
+    network_base< Type, TimeType, PulseManager >::~network_base()
     {
         /*  */
     }
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     void
-    network_base< Type, TimeType >::AddNeuron( neuron_base< Type, TimeType > * neuron )
+    network_base< Type, TimeType, PulseManager >::AddNeuron( neuron_base< Type, TimeType > * neuron )
     {
         neurons.push_back( neuron );
     }
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     void
-    network_base< Type, TimeType >::Tick()
+    network_base< Type, TimeType, PulseManager >::Tick()
     {
         pulsesProcessedLastTick = 0;
         neuronsProcessedLastTick = 0;
@@ -64,16 +64,16 @@ namespace spnn
 
     }
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     size_t
-    network_base< Type, TimeType >::QueuePulse( const pulse_base< Type, TimeType >& pulse )
+    network_base< Type, TimeType, PulseManager >::QueuePulse( const pulse_base< Type, TimeType >& pulse )
     {
         return pulses.QueuePulse( pulse );
     }
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     bool
-    network_base< Type, TimeType >::Verify( const std::set< neuron_base< Type, TimeType > * >& acceptable_neurons ) const
+    network_base< Type, TimeType, PulseManager >::Verify( const std::set< neuron_base< Type, TimeType > * >& acceptable_neurons ) const
     {
         // all neurons must be non-null, present in the given set, and verified with the given set of neurons
         for( auto p_neuron : neurons )
@@ -82,7 +82,7 @@ namespace spnn
 
             if( p_neuron == nullptr || acceptable_neurons.count( p_neuron ) == 0 || !( verifiyed = p_neuron->Verify( acceptable_neurons ) ) )
             {
-                std::cout << "network_base< Type, TimeType >::Verify Failed\n";
+                std::cout << "network_base< Type, TimeType, PulseManager >::Verify Failed\n";
                 std::cout << "\tp_neuron =   " << this << "\n";
                 std::cout << "\tpnr in set = " << acceptable_neurons.count( p_neuron ) << "\n";
                 std::cout << "\tVerifiyed =  " << verifiyed << "\n" << std::endl;
@@ -94,9 +94,9 @@ namespace spnn
         return true;
     }
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     void
-    network_base< Type, TimeType >::clear_network_state()
+    network_base< Type, TimeType, PulseManager >::clear_network_state()
     {
         pulsesProcessed = 0;
         neuronsProcessed = 0;
@@ -115,51 +115,51 @@ namespace spnn
     }
 
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     TimeType
-    network_base< Type, TimeType >::Time() const
+    network_base< Type, TimeType, PulseManager >::Time() const
     {
         return currentTime;
     }
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     TimeType
-    network_base< Type, TimeType >::DeltaTime() const
+    network_base< Type, TimeType, PulseManager >::DeltaTime() const
     {
         return deltaTime;
     }
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     size_t
-    network_base< Type, TimeType >::QueueSize() const
+    network_base< Type, TimeType, PulseManager >::QueueSize() const
     {
         return pulses.QueueSize();
     }
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     uint64_t
-    network_base< Type, TimeType >::PulsesProcessed() const
+    network_base< Type, TimeType, PulseManager >::PulsesProcessed() const
     {
         return pulsesProcessed;
     }
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     uint64_t
-    network_base< Type, TimeType >::NeuronsProcessed() const
+    network_base< Type, TimeType, PulseManager >::NeuronsProcessed() const
     {
         return neuronsProcessed;
     }
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     uint64_t
-    network_base< Type, TimeType >::PulsesProcessedLastTick() const
+    network_base< Type, TimeType, PulseManager >::PulsesProcessedLastTick() const
     {
         return pulsesProcessedLastTick;
     }
 
-    template < typename Type, typename TimeType >
+    template < typename Type, typename TimeType, typename PulseManager >
     uint64_t
-    network_base< Type, TimeType >::NeuronsProcessedLastTick() const
+    network_base< Type, TimeType, PulseManager >::NeuronsProcessedLastTick() const
     {
         return neuronsProcessedLastTick;
     }
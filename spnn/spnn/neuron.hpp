@@ -63,7 +63,8 @@ namespace spnn
 
             // methods
 
-            bool Tick( pulseManager_base< Type, TimeType >& pulse_manager, const TimeType& time, const TimeType& dTime );
+            template < typename PulseManagerType >
+            bool Tick( PulseManagerType& pulse_manager, const TimeType& time, const TimeType& dTime );
             bool AcceptPulse( const pulse_base< Type, TimeType >& pulse );
 
             size_t AddSynapse( const synapse_base< Type, TimeType >& synapse );
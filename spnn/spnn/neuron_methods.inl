@@ -9,8 +9,9 @@ namespace spnn
     // Tick Begin
 
     template < typename Type, typename TimeType >
+    template < typename PulseManagerType >
     bool
-    neuron_base< Type, TimeType >::Tick( pulseManager_base< Type, TimeType >& pulse_manager, const TimeType& time, const TimeType& dTime )
+    neuron_base< Type, TimeType >::Tick( PulseManagerType& pulse_manager, const TimeType& time, const TimeType& dTime )
     {
         // sanity checks
 
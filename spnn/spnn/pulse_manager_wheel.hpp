@@ -0,0 +1,117 @@
+#ifndef SPNN_PULSE_MANAGER_WHEEL_HPP_INCLUDED
+#define SPNN_PULSE_MANAGER_WHEEL_HPP_INCLUDED
+
+#include <vector>
+#include <queue>
+#include <type_traits>
+
+namespace spnn
+{
+    template < typename Type, typename TimeType > struct pulse_base;
+    template < typename Type, typename TimeType, typename PulseType = pulse_base< Type, TimeType > > class pulseManager_wheel_base;
+}
+
+#include "neuron.hpp"
+#include "pulse_manager.hpp"
+
+namespace spnn
+{
+    // two level timing-wheel drop in replacement for pulseManager_base
+    //   the fine wheel has one bucket per tick of the current epoch ( wheelSize ticks ), the coarse wheel has one bucket per upcoming epoch
+    //   queueing a pulse is O(1), and so is draining one when ProcessCurrentTimePulses is called with in_order false
+    //   an in order drain sorts the k pulses due that tick, which is O(k log k) per tick
+    //   a coarse bucket is cascaded into the fine wheel once when its epoch begins
+    //   pulses beyond the coarse horizon wait in an overflow heap until the coarse wheel catches up
+    //   pulses of a single call to ProcessCurrentTimePulses are delivered in the same order as pulseManager_base, by time and then destination,
+    //     but pulses that share both are delivered by value, where pulseManager_base leaves them in heap order, so a neuron's float sum can round differently
+    //   PulseType only needs time, value and destination members, destination may be a pointer or an index
+
+    template < typename Type, typename TimeType, typename PulseType >
+    class pulseManager_wheel_base
+    {
+        static_assert( std::is_integral< TimeType >::value, "pulseManager_wheel_base requires an integral TimeType." );
+
+        private:
+
+            // comparison functors of two PulseType
+
+            struct pulse_base_comp
+            {
+                bool operator()( const PulseType& l, const PulseType& r ) const;
+            };
+
+            struct pulse_base_less
+            {
+                bool operator()( const PulseType& l, const PulseType& r ) const;
+            };
+
+            // destination null check, index destinations are range checked by their owner
+
+            template < typename DestinationType >
+            static bool hasDestination( const DestinationType& destination );
+
+        protected:
+
+            // behavior variables
+
+            size_t wheelBits;  // log2 of the number of ticks in an epoch
+            size_t wheelMask;
+            size_t coarseMask;
+
+            // state
+
+            std::vector< std::vector< PulseType > > wheel;       // wheel[ time & wheelMask ], pulses of the current epoch
+            std::vector< std::vector< PulseType > > coarseWheel; // coarseWheel[ ( time >> wheelBits ) & coarseMask ], pulses of the next epochs
+
+            TimeType wheelTime; // earliest time that has not yet been drained from the wheel
+            size_t wheelCount;
+            size_t coarseCount;
+
+            std::vector< PulseType > latePulses; // pulses queued with a time stamp behind wheelTime
+            std::priority_queue< PulseType, std::vector< PulseType >, pulse_base_comp > overflowQueue; // pulses beyond the coarse horizon
+
+            std::vector< PulseType > drainBuffer;
+
+        public:
+
+            // constructor
+
+            pulseManager_wheel_base( size_t wheel_size = 4096, size_t coarse_wheel_size = 4096 );
+
+            // destructor
+
+            virtual ~pulseManager_wheel_base();
+
+            // mutators
+
+            size_t QueuePulse( const PulseType& pulse );
+
+            std::vector< PulseType > GetCurrentTimePulses( const TimeType& time );
+
+            template < typename Func >
+            size_t ProcessCurrentTimePulses( const TimeType& time, Func&& func, bool in_order = true );
+
+            void clear_all_pulses();
+
+            // accessors
+
+            size_t QueueSize() const;
+
+            TimeType NextPulseTime( const TimeType& limit ) const;
+
+        protected:
+
+            // helpers
+
+            TimeType epochOf( const TimeType& time ) const;
+
+            void placePulse( const PulseType& pulse );
+            void advanceTo( const TimeType& time );
+            void pullOverflow();
+    };
+
+}
+
+#include "pulse_manager_wheel.inl"
+
+#endif // SPNN_PULSE_MANAGER_WHEEL_HPP_INCLUDED
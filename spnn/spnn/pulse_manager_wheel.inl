@@ -0,0 +1,355 @@
+#ifndef PULSE_MANAGER_WHEEL_INL_INCLUDED
+#define PULSE_MANAGER_WHEEL_INL_INCLUDED
+
+#include <cassert>
+#include <algorithm>
+
+namespace spnn
+{
+    template < typename Type, typename TimeType, typename PulseType >
+    pulseManager_wheel_base< Type, TimeType, PulseType >::pulseManager_wheel_base( size_t wheel_size, size_t coarse_wheel_size )
+         : wheelBits( 0 ), wheelMask( 0 ), coarseMask( 0 ), wheel(), coarseWheel(), wheelTime( 0 ), wheelCount( 0 ), coarseCount( 0 ), latePulses(), overflowQueue(), drainBuffer()
+    {
+        // round both sizes up to powers of two
+        while( ( size_t( 1 ) << wheelBits ) < wheel_size )
+        {
+            ++wheelBits;
+        }
+
+        size_t coarse_size = 1;
+        while( coarse_size < coarse_wheel_size )
+        {
+            coarse_size <<= 1;
+        }
+
+        wheel.resize( size_t( 1 ) << wheelBits );
+        coarseWheel.resize( coarse_size );
+
+        wheelMask = wheel.size() - 1;
+        coarseMask = coarseWheel.size() - 1;
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    pulseManager_wheel_base< Type, TimeType, PulseType >::~pulseManager_wheel_base()
+    {
+        /*  */
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    bool
+    pulseManager_wheel_base< Type, TimeType, PulseType >::pulse_base_comp::operator()( const PulseType& l, const PulseType& r ) const
+    {
+        if( l.time == r.time )
+        {
+            if( l.destination == r.destination )
+            {
+                return l.value < r.value;
+            }
+
+            return uintptr_t(l.destination) < uintptr_t(r.destination);
+        }
+
+        // actually greater than, since we want the pulses with the smallest time-stamp to appear at the top of the queue
+        return l.time > r.time;
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    bool
+    pulseManager_wheel_base< Type, TimeType, PulseType >::pulse_base_less::operator()( const PulseType& l, const PulseType& r ) const
+    {
+        // the order pulseManager_base pops pulses in; ascending time, then descending destination address, then descending value where pulseManager_base has no set order
+        if( l.time == r.time )
+        {
+            if( l.destination == r.destination )
+            {
+                return l.value > r.value;
+            }
+
+            return uintptr_t(l.destination) > uintptr_t(r.destination);
+        }
+
+        return l.time < r.time;
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    template < typename DestinationType >
+    bool
+    pulseManager_wheel_base< Type, TimeType, PulseType >::hasDestination( const DestinationType& destination )
+    {
+        return !std::is_pointer< DestinationType >::value || destination != DestinationType();
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    size_t
+    pulseManager_wheel_base< Type, TimeType, PulseType >::QueuePulse( const PulseType& pulse )
+    {
+        // don't queue malformed pulses/pulses without destinations
+        if( !hasDestination( pulse.destination ) )
+        {
+            // return 0 on malformed pulse
+            return 0;
+        }
+
+        if( pulse.time < wheelTime )
+        {
+            latePulses.push_back( pulse );
+        }
+        else
+        {
+            placePulse( pulse );
+        }
+
+        // return the queue size on success
+        return QueueSize();
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    std::vector< PulseType >
+    pulseManager_wheel_base< Type, TimeType, PulseType >::GetCurrentTimePulses( const TimeType& time )
+    {
+        std::vector< PulseType > out;
+
+        // add the current time pulses to the output
+        ProcessCurrentTimePulses( time, [&out]( auto& pulse ){ out.emplace_back( pulse ); } );
+
+        // return the output
+        return out;
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    template < typename Func >
+    size_t
+    pulseManager_wheel_base< Type, TimeType, PulseType >::ProcessCurrentTimePulses( const TimeType& time, Func&& func, bool in_order )
+    {
+        drainBuffer.clear();
+
+        // collect the late pulses that are due
+        if( !latePulses.empty() )
+        {
+            auto due_end = std::partition( latePulses.begin(), latePulses.end(), [&time]( const auto& pulse ){ return pulse.time <= time; } );
+
+            drainBuffer.insert( drainBuffer.end(), latePulses.begin(), due_end );
+            latePulses.erase( latePulses.begin(), due_end );
+        }
+
+        // drain every bucket up to and including time
+        while( wheelTime <= time )
+        {
+            if( wheelCount == 0 )
+            {
+                if( coarseCount == 0 )
+                {
+                    // nothing on either wheel, skip straight to the next overflow pulse or past time
+                    if( overflowQueue.empty() || overflowQueue.top().time > time )
+                    {
+                        advanceTo( time + 1 );
+                        break;
+                    }
+
+                    advanceTo( overflowQueue.top().time );
+                }
+                else
+                {
+                    // nothing left in this epoch, skip to the start of the next one
+                    TimeType next_epoch = ( epochOf( wheelTime ) + 1 ) << wheelBits;
+
+                    if( next_epoch > time )
+                    {
+                        advanceTo( time + 1 );
+                        break;
+                    }
+
+                    advanceTo( next_epoch );
+                }
+
+                continue;
+            }
+
+            auto& bucket = wheel[ size_t( wheelTime ) & wheelMask ];
+
+            wheelCount -= bucket.size();
+            drainBuffer.insert( drainBuffer.end(), bucket.begin(), bucket.end() );
+            bucket.clear();
+
+            advanceTo( wheelTime + 1 );
+        }
+
+        // deliver in the order pulseManager_base would have, up to ties, unless the caller does not care
+        if( in_order )
+        {
+            std::sort( drainBuffer.begin(), drainBuffer.end(), pulse_base_less() );
+        }
+
+        for( const auto& pulse : drainBuffer )
+        {
+            func( pulse );
+        }
+
+        return drainBuffer.size();
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    void
+    pulseManager_wheel_base< Type, TimeType, PulseType >::clear_all_pulses()
+    {
+        for( auto& bucket : wheel )
+        {
+            bucket.clear();
+        }
+
+        for( auto& bucket : coarseWheel )
+        {
+            bucket.clear();
+        }
+
+        while( !overflowQueue.empty() )
+        {
+            overflowQueue.pop();
+        }
+
+        latePulses.clear();
+        drainBuffer.clear();
+
+        wheelCount = 0;
+        coarseCount = 0;
+        wheelTime = 0;
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    size_t
+    pulseManager_wheel_base< Type, TimeType, PulseType >::QueueSize() const
+    {
+        return wheelCount + coarseCount + latePulses.size() + overflowQueue.size();
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    TimeType
+    pulseManager_wheel_base< Type, TimeType, PulseType >::NextPulseTime( const TimeType& limit ) const
+    {
+        // earliest time stamp of any queued pulse, or limit if there is none before it
+        TimeType next = limit;
+
+        for( const auto& pulse : latePulses )
+        {
+            next = std::min( next, pulse.time );
+        }
+
+        if( !overflowQueue.empty() )
+        {
+            next = std::min( next, overflowQueue.top().time );
+        }
+
+        // the fine wheel only holds the current epoch, one time stamp per bucket
+        if( wheelCount )
+        {
+            TimeType epoch_end = ( epochOf( wheelTime ) + 1 ) << wheelBits;
+
+            for( TimeType time = wheelTime; time < next && time < epoch_end; ++time )
+            {
+                if( !wheel[ size_t( time ) & wheelMask ].empty() )
+                {
+                    next = time;
+                    break;
+                }
+            }
+        }
+
+        // the first non empty coarse bucket holds the earliest of the later epochs
+        if( coarseCount )
+        {
+            TimeType current_epoch = epochOf( wheelTime );
+
+            for( TimeType epoch = current_epoch + 1; ( epoch << wheelBits ) < next && size_t( epoch - current_epoch ) <= coarseMask; ++epoch )
+            {
+                const auto& bucket = coarseWheel[ size_t( epoch ) & coarseMask ];
+
+                if( !bucket.empty() )
+                {
+                    for( const auto& pulse : bucket )
+                    {
+                        next = std::min( next, pulse.time );
+                    }
+                    break;
+                }
+            }
+        }
+
+        return next;
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    TimeType
+    pulseManager_wheel_base< Type, TimeType, PulseType >::epochOf( const TimeType& time ) const
+    {
+        return time >> wheelBits;
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    void
+    pulseManager_wheel_base< Type, TimeType, PulseType >::placePulse( const PulseType& pulse )
+    {
+        assert( pulse.time >= wheelTime );
+
+        TimeType epoch_offset = epochOf( pulse.time ) - epochOf( wheelTime );
+
+        if( epoch_offset == 0 )
+        {
+            wheel[ size_t( pulse.time ) & wheelMask ].push_back( pulse );
+            ++wheelCount;
+        }
+        else if( size_t( epoch_offset ) <= coarseMask )
+        {
+            coarseWheel[ size_t( epochOf( pulse.time ) ) & coarseMask ].push_back( pulse );
+            ++coarseCount;
+        }
+        else
+        {
+            overflowQueue.push( pulse );
+        }
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    void
+    pulseManager_wheel_base< Type, TimeType, PulseType >::advanceTo( const TimeType& time )
+    {
+        TimeType old_epoch = epochOf( wheelTime );
+
+        wheelTime = time;
+
+        if( epochOf( wheelTime ) == old_epoch )
+        {
+            return;
+        }
+
+        // only ever skip epochs when the coarse wheel is empty
+        assert( coarseCount == 0 || epochOf( wheelTime ) == old_epoch + 1 );
+
+        // cascade the new epoch down into the fine wheel
+        auto& bucket = coarseWheel[ size_t( epochOf( wheelTime ) ) & coarseMask ];
+
+        for( const auto& pulse : bucket )
+        {
+            wheel[ size_t( pulse.time ) & wheelMask ].push_back( pulse );
+        }
+
+        wheelCount += bucket.size();
+        coarseCount -= bucket.size();
+        bucket.clear();
+
+        // the coarse horizon moved out, so some overflow pulses may now fit
+        pullOverflow();
+    }
+
+    template < typename Type, typename TimeType, typename PulseType >
+    void
+    pulseManager_wheel_base< Type, TimeType, PulseType >::pullOverflow()
+    {
+        while( !overflowQueue.empty() && size_t( epochOf( overflowQueue.top().time ) - epochOf( wheelTime ) ) <= coarseMask )
+        {
+            placePulse( overflowQueue.top() );
+            overflowQueue.pop();
+        }
+    }
+}
+
+#endif // PULSE_MANAGER_WHEEL_INL_INCLUDED
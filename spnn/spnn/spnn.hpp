@@ -4,7 +4,9 @@
 #include "synapse.hpp"
 #include "neuron.hpp"
 #include "pulse_manager.hpp"
+#include "pulse_manager_wheel.hpp"
 #include "network.hpp"
+#include "compiled_network.hpp"
 
 namespace spnn
 {
@@ -13,6 +15,12 @@ namespace spnn
     using neuron       = neuron_base< float, uint64_t >;
     using pulseManager = pulseManager_base< float, uint64_t >;
     using network      = network_base< float, uint64_t >;
+
+    using pulseManager_wheel = pulseManager_wheel_base< float, uint64_t >;
+    using network_wheel      = network_base< float, uint64_t, pulseManager_wheel >;
+
+    using compiled_network = compiled_network_base< float, uint64_t >;
+    using compiled_neuron  = compiled_network::neuron_view;
 }
 
 
@@ -0,0 +1,349 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "tests.hpp"
+#include "../spnn.hpp"
+
+namespace _tests
+{
+    namespace t10
+    {
+        // the hash map based distance that neat::NetworkGenotypeDistance used before the merge-join, kept as the reference
+        inline
+        double
+        HashMapDistance( const neat::NetworkGenotype& networkA, const neat::NetworkGenotype& networkB, const neat::SpeciesDistanceParameters& params )
+        {
+            double nodesDistance = 0.0;
+            double connectionsDistance = 0.0;
+
+            if( params.excess != 0.0 || params.disjoint != 0.0 || params.weights != 0.0 || params.lengths != 0.0 )
+            {
+                std::unordered_map< neat::InnovationID, const neat::ConnectionDef * > netAconnections;
+                std::unordered_map< neat::InnovationID, const neat::ConnectionDef * > netBconnections;
+                std::unordered_set< neat::InnovationID > innovations;
+
+                neat::InnovationID innovMaxA = 0;
+                neat::InnovationID innovMaxB = 0;
+
+                for( const neat::ConnectionDef& connection : networkA.getConnections() )
+                {
+                    netAconnections.emplace( connection.innovation, &connection );
+                    innovations.emplace( connection.innovation );
+                    innovMaxA = std::max( innovMaxA, connection.innovation );
+                }
+
+                for( const neat::ConnectionDef& connection : networkB.getConnections() )
+                {
+                    netBconnections.emplace( connection.innovation, &connection );
+                    innovations.emplace( connection.innovation );
+                    innovMaxB = std::max( innovMaxB, connection.innovation );
+                }
+
+                double W = 0.0;
+                double L = 0.0;
+                size_t E = 0;
+                size_t D = 0;
+                size_t numSame = 0;
+
+                for( neat::InnovationID current : innovations )
+                {
+                    auto it_connA = netAconnections.find( current );
+                    auto it_connB = netBconnections.find( current );
+
+                    const neat::ConnectionDef * connA = it_connA != netAconnections.end() ? it_connA->second : nullptr;
+                    const neat::ConnectionDef * connB = it_connB != netBconnections.end() ? it_connB->second : nullptr;
+
+                    if( connA && connB )
+                    {
+                        W += fabs( connA->weight - connB->weight );
+                        L += std::max( connA->length, connB->length ) - std::min( connA->length, connB->length );
+                        ++numSame;
+                    }
+                    else if( current > innovMaxA || current > innovMaxB )
+                    {
+                        ++E;
+                    }
+                    else
+                    {
+                        ++D;
+                    }
+                }
+
+                W /= double( numSame );
+                L /= double( numSame );
+
+                connectionsDistance = params.excess * double( E ) + params.disjoint * double( D ) + params.weights * W + params.lengths * L;
+            }
+
+            if( params.activations != 0.0 || params.decays != 0.0 || params.pulses != 0.0 || params.nodes != 0.0 )
+            {
+                std::unordered_map< neat::NodeID, const neat::NodeDef * > netAnodes;
+                std::unordered_map< neat::NodeID, const neat::NodeDef * > netBnodes;
+                std::unordered_set< neat::NodeID > commonNodes;
+
+                double T = 0.0;
+                double D = 0.0;
+                double P = 0.0;
+
+                for( const neat::NodeDef& node : networkA.getNodes() )
+                {
+                    netAnodes.emplace( node.ID, &node );
+                }
+
+                for( const neat::NodeDef& node : networkB.getNodes() )
+                {
+                    netBnodes.emplace( node.ID, &node );
+
+                    if( netAnodes.count( node.ID ) )
+                    {
+                        commonNodes.emplace( node.ID );
+                    }
+                }
+
+                size_t E = networkA.getNumNodes() + networkB.getNumNodes() - ( 2 * commonNodes.size() );
+
+                if( params.activations != 0.0 || params.decays != 0.0 || params.pulses != 0.0 )
+                {
+                    for( neat::NodeID id : commonNodes )
+                    {
+                        const neat::NodeDef * nodeA = netAnodes[ id ];
+                        const neat::NodeDef * nodeB = netBnodes[ id ];
+
+                        T += fabs( std::min( nodeA->thresholdMax, nodeA->thresholdMin ) - std::min( nodeB->thresholdMax, nodeB->thresholdMin ) );
+                        T += fabs( std::max( nodeA->thresholdMax, nodeA->thresholdMin ) - std::max( nodeB->thresholdMax, nodeB->thresholdMin ) );
+
+                        D += fabs( nodeA->valueDecay - nodeB->valueDecay );
+                        D += fabs( nodeA->activDecay - nodeB->activDecay );
+
+                        P += std::max( nodeA->pulseFast, nodeB->pulseFast ) - std::min( nodeA->pulseFast, nodeB->pulseFast );
+                        P += std::max( nodeA->pulseSlow, nodeB->pulseSlow ) - std::min( nodeA->pulseSlow, nodeB->pulseSlow );
+                    }
+
+                    T /= double( commonNodes.size() );
+                    D /= double( commonNodes.size() );
+                    P /= double( commonNodes.size() );
+                }
+
+                nodesDistance = T * params.activations + D * params.decays + P * params.pulses + params.nodes * double( E );
+            }
+
+            return connectionsDistance + nodesDistance;
+        }
+
+        inline
+        neat::NodeDef
+        RandomNode( neat::NodeID id, std::mt19937_64& gen )
+        {
+            std::uniform_real_distribution< double > threshold( -1.0, 1.0 );
+            std::uniform_real_distribution< double > decay( 0.0, 0.5 );
+            std::uniform_int_distribution< uint64_t > pulse( 1, 1000 );
+
+            neat::NodeDef node;
+            node.innovation = id;
+            node.ID = id;
+            node.thresholdMin = threshold( gen );
+            node.thresholdMax = threshold( gen );
+            node.valueDecay = decay( gen );
+            node.activDecay = decay( gen );
+            node.pulseFast = pulse( gen );
+            node.pulseSlow = pulse( gen ) * 100;
+            node.type = neat::NodeType::Hidden;
+            return node;
+        }
+
+        inline
+        neat::ConnectionDef
+        RandomConnection( neat::InnovationID innovation, size_t num_nodes, std::mt19937_64& gen )
+        {
+            std::uniform_int_distribution< neat::NodeID > node( 0, num_nodes - 1 );
+            std::uniform_real_distribution< double > weight( -2.0, 2.0 );
+            std::uniform_int_distribution< uint64_t > length( 1, 10000 );
+
+            neat::ConnectionDef connection;
+            connection.innovation = innovation;
+            connection.sourceID = node( gen );
+            connection.destinationID = node( gen );
+            connection.weight = weight( gen );
+            connection.length = length( gen );
+            connection.enabled = true;
+            return connection;
+        }
+
+        // a pair of genotypes that share an ancestor, each with its own perturbed, dropped and appended genes
+        inline
+        std::pair< neat::NetworkGenotype, neat::NetworkGenotype >
+        MakeRelatedGenotypes( size_t num_nodes, size_t num_connections, bool shuffled, uint64_t seed )
+        {
+            std::mt19937_64 gen( seed );
+
+            std::vector< neat::NodeDef > baseNodes;
+            std::vector< neat::ConnectionDef > baseConnections;
+
+            for( size_t i = 0; i < num_nodes; ++i ) { baseNodes.push_back( RandomNode( i, gen ) ); }
+            for( size_t i = 0; i < num_connections; ++i ) { baseConnections.push_back( RandomConnection( i + 1, num_nodes, gen ) ); }
+
+            std::bernoulli_distribution drop( 0.1 );
+            std::bernoulli_distribution perturb( 0.5 );
+            std::normal_distribution< double > nudge( 0.0, 0.1 );
+
+            auto derive = [&]( neat::NodeID firstNewNode, neat::InnovationID firstNewInnovation, size_t num_new )
+            {
+                std::vector< neat::NodeDef > nodes;
+                std::vector< neat::ConnectionDef > connections;
+
+                for( neat::NodeDef node : baseNodes )
+                {
+                    if( drop( gen ) ) { continue; }
+                    if( perturb( gen ) ) { node.thresholdMax += nudge( gen ); node.valueDecay = std::fabs( node.valueDecay + nudge( gen ) ); node.pulseFast += 3; }
+                    nodes.push_back( node );
+                }
+
+                for( neat::ConnectionDef connection : baseConnections )
+                {
+                    if( drop( gen ) ) { continue; }
+                    if( perturb( gen ) ) { connection.weight += nudge( gen ); connection.length += 7; }
+                    connections.push_back( connection );
+                }
+
+                for( size_t i = 0; i < num_new; ++i )
+                {
+                    nodes.push_back( RandomNode( firstNewNode + i, gen ) );
+                    connections.push_back( RandomConnection( firstNewInnovation + i * 2, num_nodes, gen ) );
+                }
+
+                if( shuffled )
+                {
+                    std::shuffle( nodes.begin(), nodes.end(), gen );
+                    std::shuffle( connections.begin(), connections.end(), gen );
+                }
+
+                return neat::make_genotype( nodes, connections );
+            };
+
+            // the new genes of A and B interleave, so that both excess and disjoint genes show up
+            size_t num_new = num_connections / 20 + 1;
+            neat::NetworkGenotype a = derive( num_nodes, num_connections + 1, num_new );
+            neat::NetworkGenotype b = derive( num_nodes + num_new / 2, num_connections + 2, num_new );
+
+            return std::make_pair( a, b );
+        }
+
+        inline
+        neat::SpeciesDistanceParameters
+        MakeParameters( double c1, double c2, double c3, double c4, double n1, double n2, double n3, double n4 )
+        {
+            neat::SpeciesDistanceParameters params;
+            params.excess = c1;
+            params.disjoint = c2;
+            params.weights = c3;
+            params.lengths = c4;
+            params.activations = n1;
+            params.decays = n2;
+            params.pulses = n3;
+            params.nodes = n4;
+            params.threshold = 1.0;
+            return params;
+        }
+
+        template< typename Func >
+        double
+        TimeDistance( Func&& func, const neat::NetworkGenotype& a, const neat::NetworkGenotype& b, const neat::SpeciesDistanceParameters& params, size_t iterations, double& result )
+        {
+            auto start_time = std::chrono::high_resolution_clock::now();
+
+            for( size_t i = 0; i < iterations; ++i )
+            {
+                result += func( a, b, params );
+            }
+
+            return std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - start_time ).count() / double( iterations );
+        }
+    }
+
+    void
+    Test10()
+    {
+        std::ios_base::sync_with_stdio( false );
+
+        struct Scenario
+        {
+            const char * name;
+            size_t num_nodes;
+            size_t num_connections;
+            bool shuffled;
+            size_t iterations;
+        };
+
+        const std::vector< Scenario > scenarios = {
+            { "small genotypes",            50,    200, false, 20000 },
+            { "medium genotypes",          500,   5000, false,  2000 },
+            { "large genotypes",          8000,  92000, false,   100 },
+            { "large genotypes, unsorted", 8000,  92000,  true,   100 },
+        };
+
+        // one term at a time, the counted terms must match exactly, the summed floating point terms only up to summation order
+        struct Term
+        {
+            const char * name;
+            neat::SpeciesDistanceParameters params;
+            bool exact;
+        };
+
+        const std::vector< Term > terms = {
+            { "excess",      t10::MakeParameters( 1, 0, 0, 0, 0, 0, 0, 0 ),  true },
+            { "disjoint",    t10::MakeParameters( 0, 1, 0, 0, 0, 0, 0, 0 ),  true },
+            { "weights",     t10::MakeParameters( 0, 0, 1, 0, 0, 0, 0, 0 ), false },
+            { "lengths",     t10::MakeParameters( 0, 0, 0, 1, 0, 0, 0, 0 ),  true },
+            { "activations", t10::MakeParameters( 0, 0, 0, 0, 1, 0, 0, 0 ), false },
+            { "decays",      t10::MakeParameters( 0, 0, 0, 0, 0, 1, 0, 0 ), false },
+            { "pulses",      t10::MakeParameters( 0, 0, 0, 0, 0, 0, 1, 0 ),  true },
+            { "nodes",       t10::MakeParameters( 0, 0, 0, 0, 0, 0, 0, 1 ),  true },
+        };
+
+        const neat::SpeciesDistanceParameters allTerms = t10::MakeParameters( 1.0, 1.0, 0.4, 0.01, 0.5, 0.5, 0.001, 1.0 );
+
+        std::cout << std::fixed;
+
+        for( const auto& scenario : scenarios )
+        {
+            auto genotypes = t10::MakeRelatedGenotypes( scenario.num_nodes, scenario.num_connections, scenario.shuffled, 10 );
+            const neat::NetworkGenotype& a = genotypes.first;
+            const neat::NetworkGenotype& b = genotypes.second;
+
+            bool identical = true;
+
+            for( const auto& term : terms )
+            {
+                double reference = t10::HashMapDistance( a, b, term.params );
+                double merged = neat::NetworkGenotypeDistance( a, b, term.params );
+
+                bool same = term.exact ? reference == merged : std::fabs( reference - merged ) <= 1e-12 * std::fabs( reference );
+
+                if( !same )
+                {
+                    std::cout << "\t" << term.name << " differs: " << std::setprecision( 17 ) << reference << " vs " << merged << "\n";
+                    identical = false;
+                }
+            }
+
+            double checksum = 0.0;
+            double hashSeconds  = t10::TimeDistance( t10::HashMapDistance, a, b, allTerms, scenario.iterations, checksum );
+            double mergeSeconds = t10::TimeDistance( neat::NetworkGenotypeDistance, a, b, allTerms, scenario.iterations, checksum );
+
+            std::cout << std::setprecision( 3 );
+            std::cout << scenario.name << " ( " << a.getNumNodes() << "/" << b.getNumNodes() << " nodes, " << a.getNumConnections() << "/" << b.getNumConnections() << " connections )\n";
+            std::cout << "\thash maps:         " << hashSeconds * 1e6 << "us\n";
+            std::cout << "\tsorted merge:      " << mergeSeconds * 1e6 << "us\n";
+            std::cout << "\tspeedup:           " << hashSeconds / mergeSeconds << "x\n";
+            std::cout << "\tmatching results:  " << ( identical ? "yes" : "NO" ) << "\n";
+            std::cout << "\tchecksum:          " << checksum << "\n" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,243 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <set>
+
+#include "tests.hpp"
+#include "../spnn.hpp"
+
+namespace _tests
+{
+    namespace t11
+    {
+        // the map based splice that neat::SpliceGenotypes used before the merge-join, kept as the reference
+        inline
+        neat::NetworkGenotype
+        MapSplice( const std::vector< const neat::NetworkGenotype* >& genotypes, std::shared_ptr< Rand::RandomFunctor > rand )
+        {
+            std::set< neat::NodeID > all_node_ids;
+            std::set< neat::InnovationID > all_innov_ids;
+            std::vector< std::map< neat::NodeID, const neat::NodeDef * > > node_maps;
+            std::vector< std::map< neat::InnovationID, const neat::ConnectionDef * > > innov_maps;
+
+            for( const neat::NetworkGenotype * genotype : genotypes )
+            {
+                node_maps.emplace_back();
+                innov_maps.emplace_back();
+
+                for( const auto& node : genotype->getNodes() )
+                {
+                    all_node_ids.emplace( node.ID );
+                    node_maps.back().emplace( node.ID, &node );
+                }
+
+                for( const auto& conn : genotype->getConnections() )
+                {
+                    all_innov_ids.emplace( conn.innovation );
+                    innov_maps.back().emplace( conn.innovation, &conn );
+                }
+            }
+
+            std::vector< neat::NodeDef > nodes;
+            std::vector< neat::ConnectionDef > conns;
+
+            for( neat::NodeID id : all_node_ids )
+            {
+                std::vector< const neat::NodeDef * > available_nodes;
+
+                for( const auto& node_map : node_maps )
+                {
+                    auto it = node_map.find( id );
+                    if( it != node_map.end() ) { available_nodes.push_back( it->second ); }
+                }
+
+                nodes.push_back( *available_nodes[ rand->Int( 0, available_nodes.size()-1 ) ] );
+            }
+
+            for( neat::InnovationID id : all_innov_ids )
+            {
+                std::vector< const neat::ConnectionDef * > available_conns;
+
+                for( const auto& innov_map : innov_maps )
+                {
+                    auto it = innov_map.find( id );
+                    if( it != innov_map.end() ) { available_conns.push_back( it->second ); }
+                }
+
+                conns.push_back( *available_conns[ rand->Int( 0, available_conns.size()-1 ) ] );
+            }
+
+            return neat::make_genotype( nodes, conns );
+        }
+
+        inline
+        neat::NodeDef
+        RandomNode( neat::NodeID id, std::mt19937_64& gen )
+        {
+            std::uniform_real_distribution< double > threshold( -1.0, 1.0 );
+            std::uniform_int_distribution< uint64_t > pulse( 1, 1000 );
+
+            neat::NodeDef node;
+            node.innovation = id;
+            node.ID = id;
+            node.thresholdMin = threshold( gen );
+            node.thresholdMax = threshold( gen );
+            node.pulseFast = pulse( gen );
+            node.pulseSlow = pulse( gen ) * 100;
+            node.type = neat::NodeType::Hidden;
+            return node;
+        }
+
+        inline
+        neat::ConnectionDef
+        RandomConnection( neat::InnovationID innovation, size_t num_nodes, std::mt19937_64& gen )
+        {
+            std::uniform_int_distribution< neat::NodeID > node( 0, num_nodes - 1 );
+            std::uniform_real_distribution< double > weight( -2.0, 2.0 );
+            std::uniform_int_distribution< uint64_t > length( 1, 10000 );
+
+            neat::ConnectionDef connection;
+            connection.innovation = innovation;
+            connection.sourceID = node( gen );
+            connection.destinationID = node( gen );
+            connection.weight = weight( gen );
+            connection.length = length( gen );
+            connection.enabled = true;
+            return connection;
+        }
+
+        // parents that share an ancestor, each missing some of its genes, with its own values, and with new genes of its own
+        inline
+        std::vector< neat::NetworkGenotype >
+        MakeParents( size_t num_parents, size_t num_nodes, size_t num_connections, bool shuffled, uint64_t seed )
+        {
+            std::mt19937_64 gen( seed );
+
+            std::vector< neat::NodeDef > baseNodes;
+            std::vector< neat::ConnectionDef > baseConnections;
+
+            for( size_t i = 0; i < num_nodes; ++i ) { baseNodes.push_back( RandomNode( i, gen ) ); }
+            for( size_t i = 0; i < num_connections; ++i ) { baseConnections.push_back( RandomConnection( i + 1, num_nodes, gen ) ); }
+
+            std::bernoulli_distribution drop( 0.1 );
+            std::normal_distribution< double > nudge( 0.0, 0.1 );
+
+            size_t num_new = num_connections / 20 + 1;
+
+            std::vector< neat::NetworkGenotype > parents;
+
+            for( size_t p = 0; p < num_parents; ++p )
+            {
+                std::vector< neat::NodeDef > nodes;
+                std::vector< neat::ConnectionDef > connections;
+
+                for( neat::NodeDef node : baseNodes )
+                {
+                    if( drop( gen ) ) { continue; }
+                    node.thresholdMax += nudge( gen );
+                    nodes.push_back( node );
+                }
+
+                for( neat::ConnectionDef connection : baseConnections )
+                {
+                    if( drop( gen ) ) { continue; }
+                    connection.weight += nudge( gen );
+                    connections.push_back( connection );
+                }
+
+                // the new genes of the parents interleave
+                for( size_t i = 0; i < num_new; ++i )
+                {
+                    nodes.push_back( RandomNode( num_nodes + i * num_parents + p, gen ) );
+                    connections.push_back( RandomConnection( num_connections + 1 + i * num_parents + p, num_nodes, gen ) );
+                }
+
+                if( shuffled )
+                {
+                    std::shuffle( nodes.begin(), nodes.end(), gen );
+                    std::shuffle( connections.begin(), connections.end(), gen );
+                }
+
+                parents.push_back( neat::make_genotype( nodes, connections ) );
+            }
+
+            return parents;
+        }
+
+        template< typename Func >
+        double
+        TimeSplice( Func&& func, const std::vector< const neat::NetworkGenotype* >& parents, size_t iterations, neat::NetworkGenotype& result )
+        {
+            auto start_time = std::chrono::high_resolution_clock::now();
+
+            for( size_t i = 0; i < iterations; ++i )
+            {
+                result = func( parents, std::make_shared< Rand::Random_Unsafe >( i ) );
+            }
+
+            return std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - start_time ).count() / double( iterations );
+        }
+    }
+
+    void
+    Test11()
+    {
+        std::ios_base::sync_with_stdio( false );
+
+        struct Scenario
+        {
+            const char * name;
+            size_t num_parents;
+            size_t num_nodes;
+            size_t num_connections;
+            bool shuffled;
+            size_t iterations;
+        };
+
+        const std::vector< Scenario > scenarios = {
+            { "small genotypes",              2,   50,   200, false, 5000 },
+            { "medium genotypes",             2,  500,  5000, false,  500 },
+            { "large genotypes",              2, 8000, 92000, false,   20 },
+            { "large genotypes, unsorted",    2, 8000, 92000,  true,   20 },
+            { "large genotypes, 4 parents",   4, 8000, 92000, false,   20 },
+        };
+
+        std::cout << std::fixed;
+
+        for( const auto& scenario : scenarios )
+        {
+            std::vector< neat::NetworkGenotype > parents = t11::MakeParents( scenario.num_parents, scenario.num_nodes, scenario.num_connections, scenario.shuffled, 11 );
+
+            std::vector< const neat::NetworkGenotype* > parent_ptrs;
+            for( const auto& parent : parents ) { parent_ptrs.push_back( &parent ); }
+
+            // both draw the same random numbers in the same order, so the same seed must give the same offspring
+            bool identical = true;
+
+            for( uint64_t seed = 0; seed < 4; ++seed )
+            {
+                neat::NetworkGenotype reference = t11::MapSplice( parent_ptrs, std::make_shared< Rand::Random_Unsafe >( seed ) );
+                neat::NetworkGenotype merged = neat::SpliceGenotypes( parent_ptrs, std::make_shared< Rand::Random_Unsafe >( seed ) );
+
+                identical = identical && reference.getNumNodes() == merged.getNumNodes() && reference.getNumConnections() == merged.getNumConnections() && reference.getContentHash() == merged.getContentHash();
+            }
+
+            neat::NetworkGenotype offspring;
+            double mapSeconds   = t11::TimeSplice( t11::MapSplice, parent_ptrs, scenario.iterations, offspring );
+            double mergeSeconds = t11::TimeSplice( []( const std::vector< const neat::NetworkGenotype* >& p, std::shared_ptr< Rand::RandomFunctor > r ){ return neat::SpliceGenotypes( p, r ); }, parent_ptrs, scenario.iterations, offspring );
+
+            std::cout << std::setprecision( 3 );
+            std::cout << scenario.name << " ( " << parents.front().getNumNodes() << " nodes, " << parents.front().getNumConnections() << " connections )\n";
+            std::cout << "\tmaps and sets:     " << mapSeconds * 1e6 << "us\n";
+            std::cout << "\tsorted merge:      " << mergeSeconds * 1e6 << "us\n";
+            std::cout << "\tspeedup:           " << mapSeconds / mergeSeconds << "x\n";
+            std::cout << "\tmatching results:  " << ( identical ? "yes" : "NO" ) << "\n";
+            std::cout << "\toffspring:         " << offspring.getNumNodes() << " nodes, " << offspring.getNumConnections() << " connections\n" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include "tests.hpp"
+#include "../spnn.hpp"
+
+namespace _tests
+{
+    namespace t12
+    {
+        // the philox4x32-10 known answer vectors from Random123 ( kat_vectors ), counter, key, then the expected output
+        struct PhiloxVector
+        {
+            uint32_t counter[4];
+            uint32_t key[2];
+            uint32_t expected[4];
+        };
+
+        const std::vector< PhiloxVector > philoxVectors = {
+            { { 0x00000000, 0x00000000, 0x00000000, 0x00000000 }, { 0x00000000, 0x00000000 }, { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+            { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff }, { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+            { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 }, { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } },
+        };
+
+        // gets to the genotypes, to compare the populations the mutations made
+        class TestPopulation : public neat::Population
+        {
+            public:
+
+                using neat::Population::Population;
+
+                const std::vector< neat::NetworkGenotype >& getGenotypes() const { return populationData; }
+        };
+
+        class TestFitnessFactory : public neat::FitnessFactory
+        {
+            public:
+
+                std::shared_ptr< neat::FitnessCalculator >
+                getNewFitnessCalculator( std::shared_ptr< neat::NetworkPhenotype >, size_t ) const override
+                {
+                    return nullptr;
+                }
+        };
+
+        // the same population mutated for a few generations on the given number of threads, the genotype hashes include the node ids and innovations
+        inline
+        std::vector< uint64_t >
+        MutatedPopulationHashes( size_t num_threads )
+        {
+            neat::MutationLimits limits;
+            neat::MutationRates rates;
+            neat::SpeciesDistanceParameters speciationParams;
+
+            // mostly structural mutations, so that many genotypes take new ids in the same generation
+            auto mutator = std::make_shared< neat::Mutations::Mutation_Multi >();
+
+            mutator->addMutator< neat::Mutations::Mutation_Conn_weight       >( 0.05 );
+            mutator->addMutator< neat::Mutations::Mutation_Add_node          >( 0.20 );
+            mutator->addMutator< neat::Mutations::Mutation_Add_conn          >( 0.20 );
+            mutator->addMutator< neat::Mutations::Mutation_Add_conn_unique   >( 0.20 );
+            mutator->addMutator< neat::Mutations::Mutation_Add_conn_dup      >( 0.20 );
+
+            TestPopulation population( 64, 3, 2, limits, rates, mutator, std::make_shared< TestFitnessFactory >(), speciationParams );
+
+            // Init draws from the global generator
+            Rand::Seed( 12 );
+            population.Init();
+
+            tpl::pool thread_pool( num_threads );
+
+            for( uint64_t generation = 0; generation < 8; ++generation )
+            {
+                population.clearGenerationConnections();
+                population.mutatePopulation( thread_pool, std::make_shared< Rand::Random_Counter >( 12, generation ) );
+            }
+
+            std::vector< uint64_t > out;
+            for( const auto& genotype : population.getGenotypes() )
+            {
+                out.push_back( genotype.getContentHash() );
+            }
+
+            return out;
+        }
+    }
+
+    void
+    Test12()
+    {
+        std::cout << std::hex << std::setfill( '0' );
+
+        bool passed = true;
+
+        for( const auto& vector : t12::philoxVectors )
+        {
+            uint32_t out[4];
+            Rand::Random_Counter::Philox( vector.counter, vector.key, out );
+
+            bool matched = out[0] == vector.expected[0] && out[1] == vector.expected[1] && out[2] == vector.expected[2] && out[3] == vector.expected[3];
+            passed = passed && matched;
+
+            std::cout << "philox4x32-10 key " << std::setw( 8 ) << vector.key[0] << " " << std::setw( 8 ) << vector.key[1] << ": ";
+            for( uint32_t word : out ) { std::cout << std::setw( 8 ) << word << " "; }
+            std::cout << ( matched ? "ok" : "MISMATCH" ) << "\n";
+        }
+
+        std::cout << std::dec << std::setfill( ' ' );
+
+        // the node ids and innovations are handed out in population order, so the thread count must not change the result
+        bool sameMutations = t12::MutatedPopulationHashes( 1 ) == t12::MutatedPopulationHashes( 8 );
+        passed = passed && sameMutations;
+
+        std::cout << "mutations on 1 and 8 threads: " << ( sameMutations ? "identical" : "DIFFERENT" ) << "\n";
+        std::cout << ( passed ? "passed" : "FAILED" ) << std::endl;
+    }
+}
@@ -84,7 +84,7 @@ namespace _tests
 
                 //virtual ~TestNodeFitnessCallback() { }
 
-                void operator()( const spnn::neuron& n ) override;
+                void operator()( const spnn::compiled_neuron& n ) override;
         };
 
         class TestFitnessCalculator : public neat::FitnessCalculator
@@ -141,7 +141,7 @@ namespace _tests
                             //callbacks.push_back( TestNodeFitnessCallback( this, callbacks.size() ) );
                             auto s = callbacks.size();
                             auto t = this;
-                            callbacks.push_back( [=]( const spnn::neuron& ){ t->nodeActivationCallback( s ); } );
+                            callbacks.push_back( [=]( const spnn::compiled_neuron& ){ t->nodeActivationCallback( s ); } );
                         }
                     }
 
@@ -259,7 +259,7 @@ namespace _tests
         };
 
         void
-        TestNodeFitnessCallback::operator()( const spnn::neuron& /*n*/ )
+        TestNodeFitnessCallback::operator()( const spnn::compiled_neuron& /*n*/ )
         {
             //std::cout << targetNodeID() << " ACTIVATION!!!" << std::endl;
             dynamic_cast<TestFitnessCalculator*>(fitnessCalculatorData())->nodeActivationCallback( targetNodeID() );
@@ -0,0 +1,102 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+
+#include "tests.hpp"
+#include "../spnn.hpp"
+
+namespace _tests
+{
+    namespace t8
+    {
+        template < typename NetworkType >
+        RunResult
+        RunNetwork( const NetworkDef& def, uint64_t num_ticks, uint64_t input_cadence )
+        {
+            std::vector< spnn::neuron > neurons;
+            neurons.reserve( def.neurons.size() );
+
+            for( const auto& n : def.neurons )
+            {
+                neurons.emplace_back( n.thresholdMin, n.thresholdMax, n.pulseFast, n.pulseSlow, n.valueDecay, n.activDecay );
+            }
+
+            NetworkType network( 1 );
+
+            for( size_t i = 0; i < def.neurons.size(); ++i )
+            {
+                for( const auto& syn : def.neurons[ i ].synapses )
+                {
+                    neurons[ i ].AddSynapse( spnn::synapse( &neurons[ syn.destination ], syn.length, syn.weight ) );
+                }
+
+                network.AddNeuron( &neurons[ i ] );
+            }
+
+            RunResult result;
+
+            auto start_time = std::chrono::high_resolution_clock::now();
+
+            while( network.Time() < num_ticks )
+            {
+                if( network.Time() % input_cadence == 0 )
+                {
+                    for( auto input : def.inputs )
+                    {
+                        network.QueuePulse( spnn::pulse( &neurons[ input ], 0, 100.0 - neurons[ input ].getValue() ) );
+                    }
+                }
+
+                network.Tick();
+
+                result.maxQueueSize = std::max( result.maxQueueSize, network.QueueSize() );
+            }
+
+            result.seconds = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - start_time ).count();
+            result.pulsesProcessed = network.PulsesProcessed();
+            result.neuronsProcessed = network.NeuronsProcessed();
+
+            for( const auto& n : neurons )
+            {
+                result.activations.push_back( n.getNumActivations() );
+            }
+
+            return result;
+        }
+    }
+
+    void
+    Test8()
+    {
+        std::ios_base::sync_with_stdio( false );
+
+        const std::vector< Scenario > scenarios = {
+            { "short synapses",  10000, 20,  100,      10, 1000 },
+            { "medium synapses", 10000, 20,  100,    1000, 1000 },
+            { "long synapses",   10000, 20,  100, 1440000, 1000 },
+            { "large phenotype", 30000, 20, 1000,    1000,  500 },
+        };
+
+        std::cout << std::fixed << std::setprecision( 3 );
+
+        for( const auto& scenario : scenarios )
+        {
+            auto def = GenerateNetworkDef( scenario.num_neurons, scenario.synapses_per_neuron, scenario.num_inputs, scenario.max_length, 1.0f, false, 8 );
+
+            auto heap  = t8::RunNetwork< spnn::network       >( def, scenario.num_ticks, scenario.input_cadence );
+            auto wheel = t8::RunNetwork< spnn::network_wheel >( def, scenario.num_ticks, scenario.input_cadence );
+
+            // the heap sums pulses that share a time and destination in heap order, the wheel by value, so a difference here can be a rounding difference
+            bool identical = heap.pulsesProcessed == wheel.pulsesProcessed && heap.neuronsProcessed == wheel.neuronsProcessed && heap.activations == wheel.activations;
+
+            std::cout << scenario.name << " ( " << scenario.num_neurons << " neurons, " << scenario.synapses_per_neuron << " synapses each, lengths 1-" << scenario.max_length << ", " << scenario.num_ticks << " ticks )\n";
+            std::cout << "\tpulses processed:  " << heap.pulsesProcessed << "\n";
+            std::cout << "\tpeak queue size:   " << heap.maxQueueSize << "\n";
+            std::cout << "\tpriority_queue:    " << heap.seconds << "s\n";
+            std::cout << "\ttiming wheel:      " << wheel.seconds << "s\n";
+            std::cout << "\tspeedup:           " << heap.seconds / wheel.seconds << "x\n";
+            std::cout << "\tidentical results: " << ( identical ? "yes" : "NO" ) << "\n" << std::endl;
+        }
+    }
+}
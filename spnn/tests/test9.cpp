@@ -0,0 +1,197 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <vector>
+
+#include "tests.hpp"
+#include "../spnn.hpp"
+
+namespace _tests
+{
+    namespace t9
+    {
+        inline
+        RunResult
+        RunObjectNetwork( const NetworkDef& def, uint64_t num_ticks, uint64_t input_cadence )
+        {
+            std::vector< spnn::neuron > neurons;
+            neurons.reserve( def.neurons.size() );
+
+            for( const auto& n : def.neurons )
+            {
+                neurons.emplace_back( n.thresholdMin, n.thresholdMax, n.pulseFast, n.pulseSlow, n.valueDecay, n.activDecay );
+            }
+
+            spnn::network_wheel network( 1 );
+
+            for( size_t i = 0; i < def.neurons.size(); ++i )
+            {
+                for( const auto& syn : def.neurons[ i ].synapses )
+                {
+                    neurons[ i ].AddSynapse( spnn::synapse( &neurons[ syn.destination ], syn.length, syn.weight ) );
+                }
+
+                network.AddNeuron( &neurons[ i ] );
+            }
+
+            RunResult result;
+
+            auto start_time = std::chrono::high_resolution_clock::now();
+
+            while( network.Time() < num_ticks )
+            {
+                if( network.Time() % input_cadence == 0 )
+                {
+                    for( auto input : def.inputs )
+                    {
+                        network.QueuePulse( spnn::pulse( &neurons[ input ], 0, 100.0f - neurons[ input ].getValue() ) );
+                    }
+                }
+
+                network.Tick();
+            }
+
+            result.seconds = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - start_time ).count();
+            result.pulsesProcessed = network.PulsesProcessed();
+            result.neuronsProcessed = network.NeuronsProcessed();
+
+            for( const auto& n : neurons )
+            {
+                result.activations.push_back( n.getNumActivations() );
+                result.values.push_back( n.getValue() );
+            }
+
+            return result;
+        }
+
+        inline
+        RunResult
+        RunCompiledNetwork( const NetworkDef& def, uint64_t num_ticks, uint64_t input_cadence, bool event_driven, bool input_port )
+        {
+            spnn::compiled_network network( 1 );
+
+            for( const auto& n : def.neurons )
+            {
+                network.AddNeuron( n.thresholdMin, n.thresholdMax, n.pulseFast, n.pulseSlow, n.valueDecay, n.activDecay );
+            }
+
+            for( size_t i = 0; i < def.neurons.size(); ++i )
+            {
+                for( const auto& syn : def.neurons[ i ].synapses )
+                {
+                    network.AddSynapse( spnn::compiled_network::index_type( i ), spnn::compiled_network::index_type( syn.destination ), syn.length, syn.weight );
+                }
+            }
+
+            network.Finalize();
+            network.setEventDriven( event_driven );
+
+            std::vector< float > input_values;
+
+            if( input_port )
+            {
+                std::vector< spnn::compiled_network::index_type > input_neurons;
+
+                for( auto input : def.inputs )
+                {
+                    input_neurons.push_back( spnn::compiled_network::index_type( input ) );
+                }
+
+                network.setInputNeurons( input_neurons );
+                input_values.assign( input_neurons.size(), 100.0f );
+            }
+
+            RunResult result;
+
+            auto start_time = std::chrono::high_resolution_clock::now();
+
+            while( network.Time() < num_ticks )
+            {
+                if( network.Time() % input_cadence == 0 )
+                {
+                    if( input_port )
+                    {
+                        network.setInputValues( input_values.data(), input_values.size() );
+                    }
+                    else
+                    {
+                        for( auto input : def.inputs )
+                        {
+                            auto index = spnn::compiled_network::index_type( input );
+                            network.QueuePulse( index, 0, 100.0f - network.Neuron( index ).getValue() );
+                        }
+                    }
+                }
+
+                // nothing is queued from outside until the next input, so event driven runs can skip ahead
+                if( event_driven )
+                {
+                    network.TickUntil( std::min( ( network.Time() / input_cadence + 1 ) * input_cadence, num_ticks ) );
+                }
+                else
+                {
+                    network.Tick();
+                }
+            }
+
+            result.seconds = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - start_time ).count();
+            // the input port does not count its inputs as pulses, the queued inputs did
+            result.pulsesProcessed = network.PulsesProcessed() + network.InputsProcessed();
+            result.neuronsProcessed = network.NeuronsProcessed();
+
+            for( size_t i = 0; i < network.NumNeurons(); ++i )
+            {
+                auto n = network.Neuron( spnn::compiled_network::index_type( i ) );
+
+                result.activations.push_back( n.getNumActivations() );
+                result.values.push_back( n.getValue() );
+            }
+
+            return result;
+        }
+    }
+
+    void
+    Test9()
+    {
+        std::ios_base::sync_with_stdio( false );
+
+        const std::vector< Scenario > scenarios = {
+            { "small phenotype",    1000, 10,   50,    100,  5000,   10 },
+            { "medium phenotype",  15000, 10,  500,   1000,  2000,   10 },
+            { "large phenotype",  100000,  5, 5000,   1000,  1000,   10 },
+            { "sparse phenotype", 100000,  2,   50,   1000, 20000, 1000 },
+            { "frame cadence",     15000,  8, 5000,  10000,  5000,  100 },
+        };
+
+        std::cout << std::fixed << std::setprecision( 3 );
+
+        for( const auto& scenario : scenarios )
+        {
+            auto def = GenerateNetworkDef( scenario.num_neurons, scenario.synapses_per_neuron, scenario.num_inputs, scenario.max_length, 5.0f, true, 9 );
+
+            auto object   = t9::RunObjectNetwork( def, scenario.num_ticks, scenario.input_cadence );
+            auto compiled = t9::RunCompiledNetwork( def, scenario.num_ticks, scenario.input_cadence, false, false );
+            auto events   = t9::RunCompiledNetwork( def, scenario.num_ticks, scenario.input_cadence, true, false );
+            auto port     = t9::RunCompiledNetwork( def, scenario.num_ticks, scenario.input_cadence, true, true );
+
+            auto same = []( const RunResult& a, const RunResult& b )
+            {
+                return a.pulsesProcessed == b.pulsesProcessed && a.neuronsProcessed == b.neuronsProcessed && a.activations == b.activations && a.values == b.values;
+            };
+
+            bool identical = same( object, compiled ) && same( object, events ) && same( object, port );
+
+            std::cout << scenario.name << " ( " << scenario.num_neurons << " neurons, " << scenario.synapses_per_neuron << " synapses each, lengths 1-" << scenario.max_length << ", " << scenario.num_ticks << " ticks )\n";
+            std::cout << "\tpulses processed:  " << object.pulsesProcessed << "\n";
+            std::cout << "\tneurons processed: " << object.neuronsProcessed << "\n";
+            std::cout << "\tnetwork_wheel:     " << object.seconds << "s\n";
+            std::cout << "\tcompiled_network:  " << compiled.seconds << "s\n";
+            std::cout << "\tevent driven:      " << events.seconds << "s\n";
+            std::cout << "\tinput port:        " << port.seconds << "s\n";
+            std::cout << "\tspeedup:           " << object.seconds / compiled.seconds << "x, " << object.seconds / events.seconds << "x event driven\n";
+            std::cout << "\tidentical results: " << ( identical ? "yes" : "NO" ) << "\n" << std::endl;
+        }
+    }
+}
@@ -2,6 +2,8 @@
 #include <windows.h>
 #endif
 
+#include <random>
+
 #include "tests.hpp"
 
 namespace _tests
@@ -21,4 +23,55 @@ namespace _tests
         SetPriorityClass( GetCurrentProcess(), IDLE_PRIORITY_CLASS );
         #endif
     }
+
+    NetworkDef
+    GenerateNetworkDef( size_t num_neurons, size_t synapses_per_neuron, size_t num_inputs, uint64_t max_length, float max_weight, bool random_neurons, uint64_t seed )
+    {
+        std::mt19937_64 gen( seed );
+        std::uniform_int_distribution< size_t > dest_dist( 0, num_neurons - 1 );
+        std::uniform_int_distribution< uint64_t > length_dist( 1, max_length );
+        std::uniform_real_distribution< float > weight_dist( -1.0f, 1.0f );
+        std::uniform_real_distribution< float > thresh_dist( 2.0f, 30.0f );
+        std::uniform_int_distribution< uint64_t > fast_dist( 1, 10 );
+        std::uniform_int_distribution< uint64_t > slow_dist( 10, 200 );
+        std::uniform_real_distribution< float > decay_dist( 0.001f, 0.5f );
+
+        NetworkDef def;
+
+        def.neurons.resize( num_neurons );
+
+        for( size_t i = 0; i < num_neurons; ++i )
+        {
+            NeuronDef& neuron = def.neurons[ i ];
+
+            if( random_neurons )
+            {
+                neuron.thresholdMin = thresh_dist( gen );
+                neuron.thresholdMax = neuron.thresholdMin + 100.0f;
+                neuron.pulseFast = fast_dist( gen );
+                neuron.pulseSlow = slow_dist( gen );
+                neuron.valueDecay = decay_dist( gen );
+                neuron.activDecay = decay_dist( gen );
+            }
+
+            for( size_t n = 0; n < synapses_per_neuron; ++n )
+            {
+                size_t dest = dest_dist( gen );
+
+                if( dest == i )
+                {
+                    continue;
+                }
+
+                neuron.synapses.push_back( SynapseDef{ dest, length_dist( gen ), weight_dist( gen ) * max_weight } );
+            }
+        }
+
+        for( size_t i = 0; i < num_inputs; ++i )
+        {
+            def.inputs.push_back( dest_dist( gen ) );
+        }
+
+        return def;
+    }
 }
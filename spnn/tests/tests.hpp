@@ -1,11 +1,67 @@
 #ifndef TESTS_HPP_INCLUDED
 #define TESTS_HPP_INCLUDED
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace _tests
 {
     void SetProcessPriority_low();
     void SetProcessPriority_lowest();
 
+    // randomly wired networks for the network benchmarks
+
+    struct SynapseDef
+    {
+        size_t destination = 0;
+        uint64_t length = 0;
+        float weight = 0.0f;
+    };
+
+    struct NeuronDef
+    {
+        float thresholdMin = 15.0f;
+        float thresholdMax = 100.0f;
+        uint64_t pulseFast = 1;
+        uint64_t pulseSlow = 100;
+        float valueDecay = 0.1f;
+        float activDecay = 0.01f;
+
+        std::vector< SynapseDef > synapses = {};
+    };
+
+    struct NetworkDef
+    {
+        std::vector< NeuronDef > neurons = {};
+        std::vector< size_t > inputs = {};
+    };
+
+    struct RunResult
+    {
+        double seconds = 0.0;
+        uint64_t pulsesProcessed = 0;
+        uint64_t neuronsProcessed = 0;
+        size_t maxQueueSize = 0;
+        std::vector< uint64_t > activations = {};
+        std::vector< float > values = {};
+    };
+
+    struct Scenario
+    {
+        const char * name = nullptr;
+        size_t num_neurons = 0;
+        size_t synapses_per_neuron = 0;
+        size_t num_inputs = 0;
+        uint64_t max_length = 0;
+        uint64_t num_ticks = 0;
+        uint64_t input_cadence = 10;
+    };
+
+    // every neuron gets synapses_per_neuron synapses ( less the ones that would loop back to itself ), weights are within +-max_weight
+    //   neurons keep the NeuronDef defaults unless random_neurons is set
+    NetworkDef GenerateNetworkDef( size_t num_neurons, size_t synapses_per_neuron, size_t num_inputs, uint64_t max_length, float max_weight, bool random_neurons, uint64_t seed );
+
     void Test(); // two neurons
     void Test2(); // massive blob of neurons
     void Test3(); // single neuron ramp-up/down
@@ -13,6 +69,11 @@ namespace _tests
     void Test5(); // splicing
     void Test6(); // population, speciation, mutation, simple fitness testing, the whole shebang!
     void Test7(); // population, speciation, mutation, simple fitness testing, the whole shebang! but with a more difficult fitness function
+    void Test8(); // pulse manager benchmark, priority_queue vs timing wheel
+    void Test9(); // network benchmark, neuron objects vs compiled_network, ticked and event driven
+    void Test10(); // genotype distance benchmark, hash maps vs sorted merge
+    void Test11(); // splicing benchmark, maps and sets vs sorted merge
+    void Test12(); // philox known answers, and mutations that come out the same on any number of threads
 }
 
 #endif // TESTS_HPP_INCLUDED